@@ -0,0 +1,176 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_ASYNC_CLIENT_HH
+# define HPP_MANIPULATION_CORBA_ASYNC_CLIENT_HH
+
+# include <deque>
+# include <stdexcept>
+# include <string>
+
+# include <boost/bind.hpp>
+# include <boost/function.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/thread.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/thread/future.hpp>
+
+# include <hpp/corbaserver/manipulation/client.hh>
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      /// Asynchronous calls to the servants of a Client.
+      ///
+      /// Each call is executed by a thread of a pool owned by this object
+      /// and its result is delivered through a future. Up to nbThreads
+      /// requests are outstanding at the same time.
+      ///
+      /// Exceptions are transported by the futures: hpp::Error is rethrown
+      /// as is by \c get (), other CORBA exceptions are rethrown as
+      /// std::runtime_error with the name of the exception.
+      ///
+      /// omniORB opens one connection per concurrent call by default. To
+      /// pipeline the requests on a single connection, give the options
+      /// <tt>-ORBoneCallPerConnection 0</tt> to the ORB of the Client.
+      ///
+      /// \code
+      /// Client client (argc, argv);
+      /// client.connect ();
+      /// AsyncClient async (client, 8);
+      /// typedef hpp::corbaserver::manipulation::_objref_Problem Problem;
+      /// AsyncClient::Future <hpp::Names_t*>::type f = async.call
+      ///   <hpp::Names_t*> (boost::bind (&Problem::getAvailable,
+      ///                                 async.problem (), "gripper"));
+      /// hpp::Names_t_var grippers = f.get ();
+      /// \endcode
+      ///
+      /// To call an operation with out parameters, bind a function that
+      /// calls it and returns the out values.
+      class HPP_MANIPULATION_CORBA_DLLAPI AsyncClient
+      {
+        public:
+          template <typename R> struct Future {
+            typedef boost::BOOST_THREAD_FUTURE <R> type;
+          };
+
+          /// \param client a connected client. Its object references are
+          ///        used by the threads of the pool.
+          /// \param nbThreads number of threads of the pool, i.e. maximal
+          ///        number of outstanding requests.
+          AsyncClient (Client& client, std::size_t nbThreads);
+
+          /// Wait for the queued calls to complete.
+          ~AsyncClient ();
+
+          hpp::corbaserver::manipulation::Graph_ptr graph () const
+          {
+            return graph_.in ();
+          }
+
+          hpp::corbaserver::manipulation::Problem_ptr problem () const
+          {
+            return problem_.in ();
+          }
+
+          hpp::corbaserver::manipulation::Robot_ptr robot () const
+          {
+            return robot_.in ();
+          }
+
+          /// Queue a call.
+          /// \param f the function to call in a thread of the pool.
+          template <typename R>
+          typename Future <R>::type call (const boost::function <R ()>& f)
+          {
+            boost::shared_ptr <boost::promise <R> > p
+              (new boost::promise <R> ());
+            typename Future <R>::type future = p->get_future ();
+            post (boost::bind (&Task <R>::run, f, p));
+            return future;
+          }
+
+          /// Number of calls queued or being executed.
+          std::size_t pending () const;
+
+        private:
+          template <typename R> static void setException
+          (boost::promise <R>& p)
+          {
+            try {
+              throw;
+            } catch (const hpp::Error& e) {
+              p.set_exception (boost::copy_exception (e));
+            } catch (const CORBA::Exception& e) {
+              p.set_exception (boost::copy_exception (std::runtime_error
+                    (std::string ("CORBA exception: ") + e._name ())));
+            } catch (const std::exception& e) {
+              p.set_exception (boost::copy_exception
+                  (std::runtime_error (e.what ())));
+            } catch (...) {
+              p.set_exception (boost::copy_exception
+                  (std::runtime_error ("Unknown exception")));
+            }
+          }
+
+          template <typename R> struct Task {
+            static void run (boost::function <R ()> f,
+                boost::shared_ptr <boost::promise <R> > p)
+            {
+              try {
+                p->set_value (f ());
+              } catch (...) {
+                setException (*p);
+              }
+            }
+          };
+
+          void post (const boost::function <void ()>& task);
+          void work ();
+
+          hpp::corbaserver::manipulation::Graph_var graph_;
+          hpp::corbaserver::manipulation::Problem_var problem_;
+          hpp::corbaserver::manipulation::Robot_var robot_;
+
+          mutable boost::mutex mutex_;
+          boost::condition_variable queued_;
+          std::deque <boost::function <void ()> > queue_;
+          std::size_t running_;
+          bool stop_;
+          boost::thread_group threads_;
+      }; // class AsyncClient
+
+      template <> struct AsyncClient::Task <void> {
+        static void run (boost::function <void ()> f,
+            boost::shared_ptr <boost::promise <void> > p)
+        {
+          try {
+            f ();
+            p->set_value ();
+          } catch (...) {
+            setException (*p);
+          }
+        }
+      };
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
+
+#endif // HPP_MANIPULATION_CORBA_ASYNC_CLIENT_HH
@@ -11,6 +11,11 @@
 #ifndef HPP_MANIPULATION_CORBA_CLIENT_HH
 # define HPP_MANIPULATION_CORBA_CLIENT_HH
 
+# include <map>
+# include <string>
+
+# include <boost/thread/mutex.hpp>
+
 # include <omniORB4/CORBA.h>
 
 # include <hpp/corbaserver/manipulation/robot.hh>
@@ -22,6 +27,11 @@
 
 namespace hpp
 {
+  namespace manipulation
+  {
+    class Server;
+  } // end of namespace manipulation.
+
   namespace corbaServer
   {
     namespace manipulation
@@ -35,6 +45,15 @@ namespace hpp
 
           void connect (const char* iiop = "corbaloc:rir:/NameService");
 
+          /// Connect to the servants of a server of the same process.
+          ///
+          /// The naming service is not used and calls are not marshalled.
+          /// Arguments are passed by reference and results are not copied,
+          /// except when the caller copies them.
+          /// \note not available when the package is built with CLIENT_ONLY.
+          /// \sa hpp::manipulation::Server::graph
+          void connect (::hpp::manipulation::Server& server);
+
           hpp::corbaserver::manipulation::Robot_var& robot () {
             return robot_;
           }
@@ -54,6 +73,98 @@ namespace hpp
 
           CORBA::ORB_var orb_;
       };
+
+      /// Cache of the results of queries whose results seldom change.
+      ///
+      /// The methods have the signature of the corresponding operations.
+      /// A result is kept until the version stamp of the part of the
+      /// problem it depends on changes (see Problem::getVersions). The
+      /// stamps are read at most once per query, so that a query answered
+      /// from the cache costs a single cheap request to the server.
+      ///
+      /// Calls are serialized. Results are returned as new copies owned by
+      /// the caller.
+      /// \note Modifications made through the servants of hpp-corbaserver
+      ///       are not tracked by the server. Call invalidate after them.
+      class HPP_MANIPULATION_CORBA_DLLAPI CachingProxy
+      {
+        public:
+          /// \param client a connected client.
+          /// \param checkEachQuery if false, the stamps are read only by
+          ///        refresh and the cache may return stale results in
+          ///        between.
+          CachingProxy (Client& client, bool checkEachQuery = true);
+
+          /// Read the version stamps and drop the outdated results.
+          void refresh ();
+
+          /// Drop all the results.
+          void invalidate ();
+
+          /// Number of queries answered from the cache.
+          std::size_t hits () const
+          {
+            return hits_;
+          }
+
+          /// Number of queries forwarded to the server.
+          std::size_t misses () const
+          {
+            return misses_;
+          }
+
+          void getGraph (hpp::corbaserver::manipulation::GraphComp_out graph,
+              hpp::corbaserver::manipulation::GraphElements_out elmts);
+
+          void getNumericalConstraints (CORBA::Long graphComponentId,
+              hpp::Names_t_out constraintNames);
+
+          hpp::Names_t* getAvailable (const char* type);
+
+          hpp::Names_t* getEnvironmentContactNames ();
+
+          char* getGripperPositionInJoint (const char* gripperName,
+              hpp::Transform__out position);
+
+          char* getHandlePositionInJoint (const char* handleName,
+              hpp::Transform__out position);
+
+        private:
+          struct Position {
+            std::string joint;
+            CORBA::Double transform [7];
+          };
+          typedef std::map <std::string, hpp::Names_t> NamesMap_t;
+          typedef std::map <CORBA::Long, hpp::Names_t> ComponentNamesMap_t;
+          typedef std::map <std::string, Position> PositionMap_t;
+
+          void check ();
+          char* position (PositionMap_t& cache, bool gripper,
+              const char* name, hpp::Transform__out position);
+
+          hpp::corbaserver::manipulation::Graph_var graph_;
+          hpp::corbaserver::manipulation::Problem_var problem_;
+          hpp::corbaserver::manipulation::Robot_var robot_;
+          bool checkEachQuery_;
+
+          boost::mutex mutex_;
+          bool valid_;
+          hpp::corbaserver::manipulation::Versions versions_;
+          std::size_t hits_, misses_;
+
+          // Depend on the graph.
+          bool hasGraph_;
+          hpp::corbaserver::manipulation::GraphComp graphComp_;
+          hpp::corbaserver::manipulation::GraphElements graphElements_;
+          ComponentNamesMap_t numericalConstraints_;
+          // Depend on the problem and on the robot.
+          NamesMap_t available_;
+          // Depend on the problem.
+          bool hasEnvironmentContactNames_;
+          hpp::Names_t environmentContactNames_;
+          // Depend on the robot.
+          PositionMap_t grippers_, handles_;
+      }; // class CachingProxy
     } // end of namespace manipulation.
   } // end of namespace corbaServer.
 } // end of namespace hpp.
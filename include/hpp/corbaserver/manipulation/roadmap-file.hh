@@ -0,0 +1,146 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_ROADMAP_FILE_HH
+# define HPP_MANIPULATION_CORBA_ROADMAP_FILE_HH
+
+# include <string>
+
+# include <boost/cstdint.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <hpp/corbaserver/manipulation/config.hh>
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      /// \name Layout of the roadmap files
+      ///
+      /// A roadmap file, written by Problem::exportRoadmap, is a
+      /// RoadmapFileHeader followed by sections at the offsets given in
+      /// the header, from the beginning of the file:
+      /// \li configurations: \c nbNodes rows of \c configSize doubles,
+      /// \li nodes: \c nbNodes RoadmapFileNode,
+      /// \li edges: \c nbEdges RoadmapFileEdge,
+      /// \li states: \c nbStates RoadmapFileString, the names of the states
+      ///     of the constraint graph referred to by the nodes.
+      ///
+      /// Sections are aligned on 8 bytes and the values are in the byte
+      /// order of the host that wrote the file, so that the file can be
+      /// mapped in memory and the sections used in place.
+      /// \{
+
+      enum {
+        ROADMAP_FILE_VERSION = 1,
+        /// State of a node saved without constraint graph.
+        ROADMAP_FILE_NO_STATE = 0xFFFFFFFF
+      };
+
+      struct RoadmapFileHeader {
+        /// "HPPRMAP" followed by a null character.
+        char magic [8];
+        boost::uint32_t version;
+        boost::uint32_t configSize;
+        boost::uint64_t nbNodes;
+        boost::uint64_t nbEdges;
+        boost::uint64_t nbStates;
+        boost::uint64_t nbConnectedComponents;
+        boost::uint64_t configurationsOffset;
+        boost::uint64_t nodesOffset;
+        boost::uint64_t edgesOffset;
+        boost::uint64_t statesOffset;
+        /// Size of the file.
+        boost::uint64_t size;
+      };
+
+      struct RoadmapFileNode {
+        /// Index of the name of the state, or ROADMAP_FILE_NO_STATE.
+        boost::uint32_t state;
+        /// Index of the connected component, from 0 to
+        /// nbConnectedComponents - 1.
+        boost::uint32_t connectedComponent;
+      };
+
+      struct RoadmapFileEdge {
+        /// Indices of the nodes.
+        boost::uint32_t from;
+        boost::uint32_t to;
+        /// Length of the path of the edge.
+        double length;
+      };
+
+      struct RoadmapFileString {
+        /// From the beginning of the file.
+        boost::uint64_t offset;
+        boost::uint64_t size;
+      };
+
+      /// \}
+
+      /// Read-only mapping of a roadmap file.
+      ///
+      /// The file is mapped in memory: opening it does not read the
+      /// sections, which are checked to lie in the file.
+      class HPP_MANIPULATION_CORBA_DLLAPI RoadmapFile
+      {
+        public:
+          /// \throw std::runtime_error if the file cannot be mapped or is
+          ///        not a roadmap file of a compatible version.
+          RoadmapFile (const std::string& filename);
+
+          ~RoadmapFile ();
+
+          const RoadmapFileHeader& header () const
+          {
+            return *header_;
+          }
+
+          /// Configuration of a node, of header ().configSize values.
+          const double* configuration (std::size_t node) const
+          {
+            return configurations_ + node * header_->configSize;
+          }
+
+          const RoadmapFileNode& node (std::size_t node) const
+          {
+            return nodes_ [node];
+          }
+
+          const RoadmapFileEdge& edge (std::size_t edge) const
+          {
+            return edges_ [edge];
+          }
+
+          std::string stateName (std::size_t state) const;
+
+        private:
+          struct Mapping;
+          boost::shared_ptr <Mapping> mapping_;
+          const char* data_;
+          const RoadmapFileHeader* header_;
+          const double* configurations_;
+          const RoadmapFileNode* nodes_;
+          const RoadmapFileEdge* edges_;
+          const RoadmapFileString* states_;
+      }; // class RoadmapFile
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
+
+#endif // HPP_MANIPULATION_CORBA_ROADMAP_FILE_HH
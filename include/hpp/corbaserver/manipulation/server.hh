@@ -28,6 +28,9 @@
 
 # include <hpp/corbaserver/manipulation/fwd.hh>
 # include <hpp/corbaserver/manipulation/config.hh>
+# include <hpp/corbaserver/manipulation/graph.hh>
+# include <hpp/corbaserver/manipulation/problem.hh>
+# include <hpp/corbaserver/manipulation/robot.hh>
 
 namespace hpp {
   namespace manipulation {
@@ -35,6 +38,16 @@ namespace hpp {
       class Graph;
       class Problem;
       class Robot;
+      class ServerMetrics;
+      class Versions;
+      class Scheduler;
+      class ModelCache;
+      class RoadmapIndex;
+      class ProjectionCache;
+      class ProjectionSessions;
+      class SceneAssemblies;
+      class LazyComponents;
+      class SolveJobs;
     }
     class HPP_MANIPULATION_CORBA_DLLAPI Server
     {
@@ -60,7 +73,97 @@ namespace hpp {
 
       corbaServer::ProblemSolverMapPtr_t problemSolverMap ();
 
+      /// \name Collocated access to the servants
+      ///
+      /// These references do not go through the naming service and calls
+      /// made with them are not marshalled: omniORB calls the servant
+      /// directly, and in arguments are passed by reference. Requests are
+      /// held until startCorbaServer has been called.
+      /// \sa hpp::corbaServer::manipulation::Client::connect (Server&)
+      /// \{
+
+      /// \return a new reference, owned by the caller.
+      hpp::corbaserver::manipulation::Graph_ptr graph ();
+      /// \return a new reference, owned by the caller.
+      hpp::corbaserver::manipulation::Problem_ptr problem ();
+      /// \return a new reference, owned by the caller.
+      hpp::corbaserver::manipulation::Robot_ptr robot ();
+
+      /// \}
+
+      /// Statistics of the operations of the servants.
+      impl::ServerMetrics& metrics ()
+      {
+        return *metrics_;
+      }
+
+      /// Version stamps of the problems, graphs and robots.
+      impl::Versions& versions ()
+      {
+        return *versions_;
+      }
+
+      /// Admission of the requests in priority classes.
+      impl::Scheduler& scheduler ()
+      {
+        return *scheduler_;
+      }
+
+      /// On-disk cache of the environment models.
+      impl::ModelCache& modelCache ()
+      {
+        return *modelCache_;
+      }
+
+      /// Nearest neighbours of the roadmap nodes, by state.
+      impl::RoadmapIndex& roadmapIndex ()
+      {
+        return *roadmapIndex_;
+      }
+
+      /// Results of the projections on the graph components.
+      impl::ProjectionCache& projectionCache ()
+      {
+        return *projectionCache_;
+      }
+
+      /// Projection sessions opened with Problem.openProjectionSession.
+      impl::ProjectionSessions& projectionSessions ()
+      {
+        return *projectionSessions_;
+      }
+
+      /// Scene assemblies started with Robot.beginSceneAssembly.
+      impl::SceneAssemblies& sceneAssemblies ()
+      {
+        return *sceneAssemblies_;
+      }
+
+      /// Planning jobs started with Problem.startSolve.
+      impl::SolveJobs& solveJobs ()
+      {
+        return *solveJobs_;
+      }
+
+      /// Graph components built on demand.
+      impl::LazyComponents& lazyComponents ()
+      {
+        return *lazyComponents_;
+      }
+
     private:
+      // Constructed first, as it registers the ORB interceptors, unless
+      // they already are.
+      impl::ServerMetrics* metrics_;
+      impl::Versions* versions_;
+      impl::Scheduler* scheduler_;
+      impl::ModelCache* modelCache_;
+      impl::RoadmapIndex* roadmapIndex_;
+      impl::ProjectionCache* projectionCache_;
+      impl::ProjectionSessions* projectionSessions_;
+      impl::SceneAssemblies* sceneAssemblies_;
+      impl::LazyComponents* lazyComponents_;
+      impl::SolveJobs* solveJobs_;
       corba::Server <impl::Graph>* graphImpl_;
       corba::Server <impl::Problem>* problemImpl_;
       corba::Server <impl::Robot>* robotImpl_;
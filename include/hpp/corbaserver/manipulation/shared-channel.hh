@@ -0,0 +1,138 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_SHARED_CHANNEL_HH
+# define HPP_MANIPULATION_CORBA_SHARED_CHANNEL_HH
+
+# include <string>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+# include <boost/shared_ptr.hpp>
+
+# include <hpp/corbaserver/manipulation/config.hh>
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      /// \name Layout of the shared-memory channels
+      ///
+      /// A channel is a POSIX shared-memory object made of a ChannelHeader
+      /// followed by a ring buffer of \c capacity bytes. The server appends
+      /// records and advances \c head; the client reads them and advances
+      /// \c tail. Both counters are byte offsets that never wrap: the
+      /// position in the ring is the counter modulo \c capacity.
+      ///
+      /// A record is a RecordHeader followed by \c size bytes, the
+      /// row-major matrix of doubles of \c rows rows and \c cols columns.
+      /// Records do not wrap around the end of the ring. When less than
+      /// the size of a RecordHeader is left before the end, the reader
+      /// skips to the beginning; otherwise the writer inserts a record of
+      /// kind RECORD_PADDING. All sizes are multiples of 8 bytes.
+      /// \{
+
+      enum {
+        /// "HPPC" in little endian.
+        CHANNEL_MAGIC = 0x43505048,
+        CHANNEL_VERSION = 1
+      };
+
+      enum RecordKind {
+        /// Space left unused at the end of the ring.
+        RECORD_PADDING = 0,
+        /// One configuration per row.
+        RECORD_CONFIGURATIONS = 1,
+        /// One sample per row: the parameter followed by the configuration.
+        RECORD_PATH_SAMPLES = 2
+      };
+
+      struct ChannelHeader {
+        boost::uint32_t magic;
+        boost::uint32_t version;
+        boost::uint64_t capacity;
+        /// Bytes written since creation. Written by the server only.
+        volatile boost::uint64_t head;
+        /// Bytes read since creation. Written by the client only.
+        volatile boost::uint64_t tail;
+        boost::uint64_t reserved [4];
+      };
+
+      struct RecordHeader {
+        boost::uint32_t kind;
+        boost::uint32_t cols;
+        /// Number of the record, starting at 0, as returned by the
+        /// operation that wrote it.
+        boost::uint64_t sequence;
+        boost::uint64_t rows;
+        /// Size of the data, in bytes.
+        boost::uint64_t size;
+      };
+
+      /// \}
+
+      /// Client side of a shared-memory channel.
+      ///
+      /// \code
+      /// CORBA::String_var name;
+      /// CORBA::ULongLong size;
+      /// hpp::ID id = client.problem ()->openSharedChannel (1 << 24,
+      ///     name.out (), size);
+      /// SharedChannelReader reader (name.in ());
+      /// client.problem ()->sendPathSamples (id, 0, 0.01);
+      /// SharedChannelReader::Record record;
+      /// while (!reader.read (record)) ;
+      /// \endcode
+      class HPP_MANIPULATION_CORBA_DLLAPI SharedChannelReader
+      {
+        public:
+          struct Record {
+            RecordKind kind;
+            boost::uint64_t sequence;
+            std::size_t rows;
+            std::size_t cols;
+            /// Row-major matrix.
+            std::vector <double> data;
+          };
+
+          /// Map the channel.
+          /// \param name name returned by Problem::openSharedChannel.
+          /// \throw std::runtime_error if the channel cannot be mapped or
+          ///        is not a channel of a compatible version.
+          SharedChannelReader (const std::string& name);
+
+          ~SharedChannelReader ();
+
+          /// Read the next record, if any.
+          /// \return false if the channel is empty.
+          bool read (Record& record);
+
+          /// Number of bytes written and not read yet.
+          std::size_t available () const;
+
+        private:
+          struct Mapping;
+          boost::shared_ptr <Mapping> mapping_;
+          ChannelHeader* header_;
+          const char* data_;
+      }; // class SharedChannelReader
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
+
+#endif // HPP_MANIPULATION_CORBA_SHARED_CHANNEL_HH
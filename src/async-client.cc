@@ -0,0 +1,78 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "hpp/corbaserver/manipulation/async-client.hh"
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      AsyncClient::AsyncClient (Client& client, std::size_t nbThreads) :
+        graph_ (client.graph ()), problem_ (client.problem ()),
+        robot_ (client.robot ()), running_ (0), stop_ (false)
+      {
+        if (nbThreads == 0) nbThreads = 1;
+        for (std::size_t i = 0; i < nbThreads; ++i)
+          threads_.create_thread (boost::bind (&AsyncClient::work, this));
+      }
+
+      AsyncClient::~AsyncClient ()
+      {
+        {
+          boost::mutex::scoped_lock lock (mutex_);
+          stop_ = true;
+          queued_.notify_all ();
+        }
+        threads_.join_all ();
+      }
+
+      std::size_t AsyncClient::pending () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return queue_.size () + running_;
+      }
+
+      void AsyncClient::post (const boost::function <void ()>& task)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        queue_.push_back (task);
+        queued_.notify_one ();
+      }
+
+      void AsyncClient::work ()
+      {
+        while (true) {
+          boost::function <void ()> task;
+          {
+            boost::mutex::scoped_lock lock (mutex_);
+            while (!stop_ && queue_.empty ()) queued_.wait (lock);
+            // Queued calls are executed before the threads stop.
+            if (queue_.empty ()) return;
+            task = queue_.front ();
+            queue_.pop_front ();
+            ++running_;
+          }
+          // Exceptions are caught by the task and stored in its future.
+          task ();
+          boost::mutex::scoped_lock lock (mutex_);
+          --running_;
+        }
+      }
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
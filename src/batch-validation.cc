@@ -0,0 +1,150 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "batch-validation.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <hpp/util/debug.hh>
+#include <hpp/util/pointer.hh>
+
+#include <hpp/pinocchio/collision-object.hh>
+#include <hpp/pinocchio/device.hh>
+#include <hpp/core/collision-validation.hh>
+#include <hpp/core/collision-validation-report.hh>
+#include <hpp/core/problem.hh>
+
+#include <hpp/manipulation/device.hh>
+#include <hpp/manipulation/problem-solver.hh>
+
+#include "environment-model.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        /// Number of rows taken at once by a worker.
+        const size_type chunk = 16;
+
+        /// Replace the name of a merged obstacle by the one of the mesh of
+        /// the triangle in contact.
+        void pieceName (const fcl::CollisionGeometry* geometry, int triangle,
+            std::string& name)
+        {
+          const MergedMesh* merged =
+            dynamic_cast <const MergedMesh*> (geometry);
+          if (merged != NULL && !merged->pieces.empty ())
+            name = merged->piece (triangle);
+        }
+
+        /// Check the rows [next, end) of the matrix, shared with other
+        /// workers, on a copy of the robot.
+        struct Validator {
+          const DevicePtr_t& robot;
+          const core::ObjectStdVector_t& obstacles;
+          const matrix_t& configs;
+          BatchValidation::Results_t& results;
+          size_type& next;
+          boost::mutex& mutex;
+          std::string& error;
+
+          void operator() ()
+          {
+            try {
+              check ();
+            } catch (const std::exception& e) {
+              boost::mutex::scoped_lock lock (mutex);
+              error = e.what ();
+              next = configs.rows ();
+            }
+          }
+
+          void check ()
+          {
+            core::DevicePtr_t copy (pinocchio::Device::createCopy (robot));
+            core::CollisionValidationPtr_t validation =
+              core::CollisionValidation::create (copy);
+            for (std::size_t i = 0; i < obstacles.size (); ++i)
+              validation->addObstacle (obstacles[i]);
+            while (true) {
+              size_type begin, end;
+              {
+                boost::mutex::scoped_lock lock (mutex);
+                if (next >= configs.rows ()) return;
+                begin = next;
+                end = next = std::min (next + chunk, configs.rows ());
+              }
+              for (size_type i = begin; i < end; ++i) {
+                BatchValidation::Result& r = results [i];
+                core::ValidationReportPtr_t report;
+                r.valid = validation->validate
+                  (configs.row (i).transpose (), report);
+                core::CollisionValidationReportPtr_t collision =
+                  HPP_DYNAMIC_PTR_CAST (core::CollisionValidationReport,
+                      report);
+                if (!r.valid && collision) {
+                  r.object1 = collision->object1->name ();
+                  r.object2 = collision->object2->name ();
+                  if (collision->result.numContacts () > 0) {
+                    const fcl::Contact& c = collision->result.getContact (0);
+                    pieceName (c.o1, c.b1, r.object1);
+                    pieceName (c.o2, c.b2, r.object2);
+                  }
+                }
+              }
+            }
+          }
+        };
+      }
+
+      BatchValidation::Results_t BatchValidation::validate
+      (const ProblemSolverPtr_t& problemSolver, const matrix_t& configs)
+      {
+        DevicePtr_t robot = problemSolver->robot ();
+        if (!robot) throw std::runtime_error ("No robot loaded");
+        if (configs.rows () > 0 && configs.cols () != robot->configSize ())
+          throw std::invalid_argument ("Configurations do not have the size"
+              " of the robot configuration");
+        const core::ObjectStdVector_t& obstacles =
+          problemSolver->problem ()->collisionObstacles ();
+
+        Results_t results (configs.rows ());
+        size_type next = 0;
+        boost::mutex mutex;
+        std::string error;
+        Validator validator = { robot, obstacles, configs, results, next,
+          mutex, error };
+        std::size_t n = std::min <std::size_t>
+          (std::max (boost::thread::hardware_concurrency (), 1u),
+           (configs.rows () + chunk - 1) / chunk);
+        boost::thread_group workers;
+        // The calling thread is one of the workers.
+        for (std::size_t i = 1; i < n; ++i)
+          workers.create_thread (validator);
+        validator ();
+        workers.join_all ();
+        if (!error.empty ()) throw std::runtime_error (error);
+        hppDout (info, "Checked " << configs.rows () << " configurations on "
+            << n << " threads");
+        return results;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,52 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_BATCH_VALIDATION_HH
+# define HPP_MANIPULATION_CORBA_BATCH_VALIDATION_HH
+
+# include <string>
+# include <vector>
+
+# include <hpp/manipulation/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Collision checks of many configurations.
+      ///
+      /// The configurations are checked in parallel. Each thread checks
+      /// them on its own copy of the robot, with a collision validation
+      /// against the obstacles of the problem.
+      struct BatchValidation
+      {
+        struct Result {
+          bool valid;
+          /// Names of the first colliding pair found, if not valid.
+          std::string object1, object2;
+        };
+        typedef std::vector <Result> Results_t;
+
+        /// \param configs rows of a configuration matrix.
+        /// \throw std::invalid_argument if a configuration does not have
+        ///        the size of the robot configuration.
+        static Results_t validate (const ProblemSolverPtr_t& problemSolver,
+            const matrix_t& configs);
+      }; // struct BatchValidation
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_BATCH_VALIDATION_HH
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_BENCHMARK_MODELS_HH
+# define HPP_MANIPULATION_CORBA_BENCHMARK_MODELS_HH
+
+# include <sstream>
+# include <string>
+
+namespace hpp {
+  namespace manipulation {
+    namespace benchmark {
+      /// \name Synthetic models
+      ///
+      /// Models used by the benchmark tools, so that they do not depend on
+      /// any installed robot description package. The scene is made of
+      /// \li a serial arm "arm" with a gripper "arm/gripper" on its last link,
+      /// \li a box "box" with a handle "box/handle" and a contact surface
+      ///     "box/bottom", to be inserted with a "freeflyer" root joint,
+      /// \li a table with a contact surface "table/top", to be loaded as an
+      ///     environment with prefix "table".
+      /// \{
+
+      inline std::string inertial ()
+      {
+        return "<inertial><mass value=\"1\"/>"
+          "<inertia ixx=\"0.01\" ixy=\"0\" ixz=\"0\" iyy=\"0.01\" iyz=\"0\""
+          " izz=\"0.01\"/></inertial>";
+      }
+
+      inline std::string boxGeometry (const char* origin, const char* size)
+      {
+        std::ostringstream os;
+        os << "<origin xyz=\"" << origin << "\" rpy=\"0 0 0\"/>"
+          "<geometry><box size=\"" << size << "\"/></geometry>";
+        return "<visual>" + os.str () + "</visual><collision>" + os.str ()
+          + "</collision>";
+      }
+
+      /// Serial arm with nbJoints revolute joints with alternate axes.
+      inline std::string armUrdf (std::size_t nbJoints)
+      {
+        std::ostringstream os;
+        os << "<robot name=\"arm\">\n"
+          << "  <link name=\"base_link\">" << inertial ()
+          << boxGeometry ("0 0 0.05", "0.2 0.2 0.1") << "</link>\n";
+        for (std::size_t i = 1; i <= nbJoints; ++i) {
+          os << "  <joint name=\"joint_" << i << "\" type=\"revolute\">"
+            << "<parent link=\"";
+          if (i == 1) os << "base_link";
+          else os << "link_" << i - 1;
+          os << "\"/><child link=\"link_" << i << "\"/>"
+            << "<origin xyz=\"0 0 " << (i == 1 ? 0.1 : 0.3)
+            << "\" rpy=\"0 0 0\"/>"
+            << "<axis xyz=\"" << (i % 2 ? "0 0 1" : "0 1 0") << "\"/>"
+            << "<limit lower=\"-3.14\" upper=\"3.14\" effort=\"10\""
+            " velocity=\"1\"/></joint>\n"
+            << "  <link name=\"link_" << i << "\">" << inertial ()
+            << boxGeometry ("0 0 0.15", "0.06 0.06 0.28") << "</link>\n";
+        }
+        os << "</robot>\n";
+        return os.str ();
+      }
+
+      inline std::string armSrdf (std::size_t nbJoints)
+      {
+        std::ostringstream os;
+        os << "<robot name=\"arm\">\n"
+          << "  <gripper name=\"gripper\" clearance=\"0.05\">"
+          << "<position xyz=\"0 0 0.35\" rpy=\"0 0 0\"/>"
+          << "<link name=\"link_" << nbJoints << "\"/></gripper>\n"
+          << "</robot>\n";
+        return os.str ();
+      }
+
+      inline std::string boxUrdf ()
+      {
+        return "<robot name=\"box\">\n"
+          "  <link name=\"base_link\">" + inertial ()
+          + boxGeometry ("0 0 0", "0.1 0.1 0.1") + "</link>\n"
+          "</robot>\n";
+      }
+
+      inline std::string boxSrdf ()
+      {
+        return "<robot name=\"box\">\n"
+          "  <handle name=\"handle\" clearance=\"0.05\">"
+          "<position xyz=\"0 0 0\" rpy=\"0 0 0\"/>"
+          "<link name=\"base_link\"/></handle>\n"
+          "  <contact name=\"bottom\"><link name=\"base_link\"/>"
+          "<point>-0.05 -0.05 -0.05  -0.05 0.05 -0.05  0.05 0.05 -0.05"
+          "  0.05 -0.05 -0.05</point><shape>4 0 1 2 3</shape></contact>\n"
+          "</robot>\n";
+      }
+
+      inline std::string tableUrdf ()
+      {
+        return "<robot name=\"table\">\n"
+          "  <link name=\"table\">" + inertial ()
+          + boxGeometry ("0.6 0 0.45", "0.6 1.2 0.1") + "</link>\n"
+          "</robot>\n";
+      }
+
+      inline std::string tableSrdf ()
+      {
+        return "<robot name=\"table\">\n"
+          "  <contact name=\"top\"><link name=\"table\"/>"
+          "<point>0.3 -0.6 0.5  0.9 -0.6 0.5  0.9 0.6 0.5  0.3 0.6 0.5</point>"
+          "<shape>4 0 1 2 3</shape></contact>\n"
+          "</robot>\n";
+      }
+
+      /// \}
+    } // namespace benchmark
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_BENCHMARK_MODELS_HH
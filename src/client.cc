@@ -16,6 +16,10 @@
 
 #include "hpp/corbaserver/manipulation/client.hh"
 
+#ifndef HPP_MANIPULATION_CORBA_CLIENT_ONLY
+# include "hpp/corbaserver/manipulation/server.hh"
+#endif
+
 #include <iostream>
 
 namespace hpp
@@ -73,10 +77,171 @@ namespace hpp
         graph_ = hpp::corbaserver::manipulation::Graph::_narrow(managerObj.in());
       }
 
+#ifndef HPP_MANIPULATION_CORBA_CLIENT_ONLY
+      void Client::connect (::hpp::manipulation::Server& server)
+      {
+        robot_ = server.robot ();
+        problem_ = server.problem ();
+        graph_ = server.graph ();
+      }
+#endif
+
       /// \brief Shutdown CORBA server
       Client::~Client()
       {
       }
+
+      CachingProxy::CachingProxy (Client& client, bool checkEachQuery) :
+        graph_ (client.graph ()), problem_ (client.problem ()),
+        robot_ (client.robot ()), checkEachQuery_ (checkEachQuery),
+        valid_ (false), hits_ (0), misses_ (0), hasGraph_ (false),
+        hasEnvironmentContactNames_ (false)
+      {}
+
+      void CachingProxy::refresh ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        check ();
+      }
+
+      void CachingProxy::invalidate ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        valid_ = false;
+        hasGraph_ = false;
+        numericalConstraints_.clear ();
+        available_.clear ();
+        hasEnvironmentContactNames_ = false;
+        grippers_.clear ();
+        handles_.clear ();
+      }
+
+      void CachingProxy::check ()
+      {
+        hpp::corbaserver::manipulation::Versions v = problem_->getVersions ();
+        bool graph = !valid_ || v.graph != versions_.graph;
+        bool problem = !valid_ || v.problem != versions_.problem;
+        bool robot = !valid_ || v.robot != versions_.robot;
+        if (graph) {
+          hasGraph_ = false;
+          numericalConstraints_.clear ();
+        }
+        if (problem || robot) available_.clear ();
+        if (problem) hasEnvironmentContactNames_ = false;
+        if (robot) {
+          grippers_.clear ();
+          handles_.clear ();
+        }
+        versions_ = v;
+        valid_ = true;
+      }
+
+      void CachingProxy::getGraph
+      (hpp::corbaserver::manipulation::GraphComp_out graph,
+       hpp::corbaserver::manipulation::GraphElements_out elmts)
+      {
+        using hpp::corbaserver::manipulation::GraphComp;
+        using hpp::corbaserver::manipulation::GraphElements;
+        boost::mutex::scoped_lock lock (mutex_);
+        if (checkEachQuery_ || !valid_) check ();
+        if (hasGraph_) {
+          ++hits_;
+        } else {
+          ++misses_;
+          hpp::corbaserver::manipulation::GraphComp_var g;
+          hpp::corbaserver::manipulation::GraphElements_var e;
+          graph_->getGraph (g.out (), e.out ());
+          graphComp_ = g.in ();
+          graphElements_ = e.in ();
+          hasGraph_ = true;
+        }
+        graph = new GraphComp (graphComp_);
+        elmts = new GraphElements (graphElements_);
+      }
+
+      void CachingProxy::getNumericalConstraints
+      (CORBA::Long graphComponentId, hpp::Names_t_out constraintNames)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (checkEachQuery_ || !valid_) check ();
+        ComponentNamesMap_t::const_iterator it =
+          numericalConstraints_.find (graphComponentId);
+        if (it != numericalConstraints_.end ()) {
+          ++hits_;
+        } else {
+          ++misses_;
+          hpp::Names_t_var names;
+          graph_->getNumericalConstraints (graphComponentId, names.out ());
+          it = numericalConstraints_.insert
+            (std::make_pair (graphComponentId, names.in ())).first;
+        }
+        constraintNames = new hpp::Names_t (it->second);
+      }
+
+      hpp::Names_t* CachingProxy::getAvailable (const char* type)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (checkEachQuery_ || !valid_) check ();
+        NamesMap_t::const_iterator it = available_.find (type);
+        if (it != available_.end ()) {
+          ++hits_;
+        } else {
+          ++misses_;
+          hpp::Names_t_var names = problem_->getAvailable (type);
+          it = available_.insert
+            (std::make_pair (std::string (type), names.in ())).first;
+        }
+        return new hpp::Names_t (it->second);
+      }
+
+      hpp::Names_t* CachingProxy::getEnvironmentContactNames ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (checkEachQuery_ || !valid_) check ();
+        if (hasEnvironmentContactNames_) {
+          ++hits_;
+        } else {
+          ++misses_;
+          hpp::Names_t_var names = problem_->getEnvironmentContactNames ();
+          environmentContactNames_ = names.in ();
+          hasEnvironmentContactNames_ = true;
+        }
+        return new hpp::Names_t (environmentContactNames_);
+      }
+
+      char* CachingProxy::getGripperPositionInJoint (const char* gripperName,
+          hpp::Transform__out position)
+      {
+        return this->position (grippers_, true, gripperName, position);
+      }
+
+      char* CachingProxy::getHandlePositionInJoint (const char* handleName,
+          hpp::Transform__out position)
+      {
+        return this->position (handles_, false, handleName, position);
+      }
+
+      char* CachingProxy::position (PositionMap_t& cache, bool gripper,
+          const char* name, hpp::Transform__out position)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (checkEachQuery_ || !valid_) check ();
+        PositionMap_t::const_iterator it = cache.find (name);
+        if (it != cache.end ()) {
+          ++hits_;
+        } else {
+          ++misses_;
+          Position p;
+          CORBA::String_var joint = gripper
+            ? robot_->getGripperPositionInJoint (name, p.transform)
+            : robot_->getHandlePositionInJoint (name, p.transform);
+          p.joint = joint.in ();
+          it = cache.insert (std::make_pair (std::string (name), p)).first;
+        }
+        for (std::size_t i = 0; i < 7; ++i)
+          position [i] = it->second.transform [i];
+        return CORBA::string_dup (it->second.joint.c_str ());
+      }
     } // end of namespace manipulation.
   } // end of namespace corbaServer.
 } // end of namespace hpp.
@@ -0,0 +1,193 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "environment-model.hh"
+
+#include <cassert>
+#include <stdexcept>
+
+#include <pinocchio/multibody/model.hpp>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+
+#include <hpp/util/debug.hh>
+#include <hpp/pinocchio/gripper.hh>
+#include <hpp/pinocchio/joint.hh>
+#include <hpp/pinocchio/collision-object.hh>
+#include <hpp/manipulation/device.hh>
+#include <hpp/manipulation/handle.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        typedef fcl::BVHModel <fcl::OBBRSS> Mesh_t;
+      }
+
+      const std::string EnvironmentModel::mergedName ("merged_obstacles");
+
+      const std::string& MergedMesh::piece (int triangle) const
+      {
+        assert (!pieces.empty ());
+        // Last piece starting at or before the triangle.
+        std::size_t i = pieces.size ();
+        while (i > 1 && pieces [i-1].first > triangle) --i;
+        return pieces [i-1].second;
+      }
+
+      EnvironmentModel EnvironmentModel::fromDevice
+      (const DevicePtr_t& object)
+      {
+        EnvironmentModel env;
+        object->controlComputation(Device::JOINT_POSITION);
+        object->computeForwardKinematics();
+        object->updateGeometryPlacements();
+
+        // Detach objects from joints
+        using pinocchio::DeviceObjectVector;
+        DeviceObjectVector& objects = object->objectVector();
+        for (DeviceObjectVector::iterator itObj = objects.begin();
+            itObj != objects.end(); ++itObj) {
+          const fcl::CollisionObject& o = *(*itObj)->fcl ();
+          Obstacle obstacle;
+          obstacle.name = (*itObj)->name ();
+          obstacle.geometry = o.collisionGeometry ();
+          obstacle.position = o.getTransform ();
+          env.obstacles.push_back (obstacle);
+        }
+
+        typedef core::Container<JointAndShapes_t>::Map_t ShapeMap;
+        const ShapeMap& m = object->jointAndShapes.map;
+        for (ShapeMap::const_iterator it = m.begin ();
+            it != m.end (); it++) {
+          Contact_t contact (it->first, std::vector <Shape_t> ());
+          for (JointAndShapes_t::const_iterator itT = it->second.begin ();
+              itT != it->second.end(); ++itT) {
+            const Transform3f& M = itT->first->currentTransformation ();
+            Shape_t newShape (itT->second.size());
+            for (std::size_t i = 0; i < newShape.size (); ++i)
+              newShape [i] = M.act (itT->second[i]);
+            contact.second.push_back (newShape);
+          }
+          env.contacts.push_back (contact);
+        }
+
+        typedef core::Container<HandlePtr_t>::Map_t HandleMap;
+        for (HandleMap::const_iterator it = object->handles.map.begin ();
+            it != object->handles.map.end (); ++it) {
+          const HandlePtr_t& h = it->second;
+          Frame f;
+          f.name = h->name ();
+          f.position = (h->joint()
+              ? h->joint()->currentTransformation() * h->localPosition()
+              : h->localPosition());
+          f.clearance = h->clearance ();
+          env.handles.push_back (f);
+        }
+
+        typedef core::Container<GripperPtr_t>::Map_t GripperMap;
+        for (GripperMap::const_iterator it = object->grippers.map.begin ();
+            it != object->grippers.map.end (); ++it) {
+          const GripperPtr_t& g = it->second;
+          Frame f;
+          f.name = g->name ();
+          f.position = (g->joint()
+              ? g->joint()->currentTransformation() * g->objectPositionInJoint()
+              : g->objectPositionInJoint());
+          f.clearance = g->clearance ();
+          env.grippers.push_back (f);
+        }
+        return env;
+      }
+
+      void EnvironmentModel::insert (const ProblemSolverPtr_t& problemSolver,
+          const DevicePtr_t& robot, const std::string& p, bool merge) const
+      {
+        // Triangles of the meshes, in the world frame.
+        std::vector <fcl::Vec3f> vertices;
+        std::vector <fcl::Triangle> triangles;
+        std::vector <std::pair <int, std::string> > pieces;
+        for (std::size_t i = 0; i < obstacles.size (); ++i) {
+          fcl::CollisionObject o (obstacles[i].geometry,
+              obstacles[i].position);
+          const Mesh_t* mesh = (merge
+              ? dynamic_cast <const Mesh_t*> (obstacles[i].geometry.get ())
+              : NULL);
+          if (mesh == NULL) {
+            problemSolver->addObstacle (p + obstacles[i].name, o, true, true);
+            hppDout (info, "Adding obstacle " << obstacles[i].name);
+            continue;
+          }
+          pieces.push_back (std::make_pair ((int) triangles.size (),
+                p + obstacles[i].name));
+          const std::size_t offset = vertices.size ();
+          for (int j = 0; j < mesh->num_vertices; ++j)
+            vertices.push_back
+              (obstacles[i].position.transform (mesh->vertices [j]));
+          for (int j = 0; j < mesh->num_tris; ++j) {
+            const fcl::Triangle& t = mesh->tri_indices [j];
+            triangles.push_back (fcl::Triangle
+                (offset + t[0], offset + t[1], offset + t[2]));
+          }
+          problemSolver->addObstacle (p + obstacles[i].name, o, false, true);
+          hppDout (info, "Adding merged obstacle " << obstacles[i].name);
+        }
+        if (!triangles.empty ()) {
+          boost::shared_ptr <MergedMesh> merged (new MergedMesh);
+          merged->pieces = pieces;
+          merged->beginModel ((int) triangles.size (), (int) vertices.size ());
+          merged->addSubModel (vertices, triangles);
+          merged->endModel ();
+          fcl::CollisionObject o (merged, fcl::Transform3f ());
+          problemSolver->addObstacle (p + mergedName, o, true, false);
+          hppDout (info, "Adding obstacle " << mergedName << " with "
+              << triangles.size () << " triangles");
+        }
+
+        for (std::size_t i = 0; i < contacts.size (); ++i) {
+          JointAndShapes_t shapes;
+          for (std::size_t j = 0; j < contacts[i].second.size (); ++j)
+            shapes.push_back (JointAndShape_t (JointPtr_t(),
+                  contacts[i].second[j]));
+          problemSolver->jointAndShapes.add (p + contacts[i].first, shapes);
+        }
+
+        for (std::size_t i = 0; i < handles.size (); ++i) {
+          HandlePtr_t h = Handle::create (p + handles[i].name,
+              handles[i].position, JointPtr_t(new Joint(robot, 0)));
+          h->clearance (handles[i].clearance);
+          robot->handles.add (h->name (), h);
+        }
+
+        se3::Model& model = robot->model();
+        for (std::size_t i = 0; i < grippers.size (); ++i) {
+          const std::string name = p + grippers[i].name;
+          if (model.existFrame(name))
+            throw std::invalid_argument ("Could not add the gripper because a frame \'" + name + "\" already exists.");
+          model.addFrame (se3::Frame(
+                name,
+                model.getJointId("universe"),
+                model.getFrameId("universe"),
+                grippers[i].position,
+                se3::OP_FRAME));
+          GripperPtr_t g = pinocchio::Gripper::create(name, robot);
+          g->clearance (grippers[i].clearance);
+          robot->grippers.add (g->name (), g);
+        }
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_ENVIRONMENT_MODEL_HH
+# define HPP_MANIPULATION_CORBA_ENVIRONMENT_MODEL_HH
+
+# include <string>
+# include <utility>
+# include <vector>
+
+# include <boost/shared_ptr.hpp>
+
+# include <hpp/fcl/collision_object.h>
+# include <hpp/fcl/BVH/BVH_model.h>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/problem-solver.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Meshes of an environment merged into a single obstacle.
+      ///
+      /// It keeps the name of the mesh each triangle comes from, so that a
+      /// contact with the merged obstacle can be reported on that mesh.
+      struct MergedMesh : fcl::BVHModel <fcl::OBBRSS>
+      {
+        /// Index of the first triangle and prefixed name of each mesh, by
+        /// increasing index.
+        std::vector <std::pair <int, std::string> > pieces;
+
+        /// Name of the mesh of a triangle.
+        const std::string& piece (int triangle) const;
+      }; // struct MergedMesh
+
+      /// Environment model ready to be inserted in a problem.
+      ///
+      /// Positions are expressed in the world frame and names are not
+      /// prefixed. The geometries are shared by all the problems in which
+      /// the model is inserted.
+      struct EnvironmentModel
+      {
+        typedef boost::shared_ptr <fcl::CollisionGeometry> GeometryPtr_t;
+
+        struct Obstacle {
+          std::string name;
+          GeometryPtr_t geometry;
+          fcl::Transform3f position;
+        };
+
+        /// Handle or gripper.
+        struct Frame {
+          std::string name;
+          Transform3f position;
+          value_type clearance;
+        };
+
+        typedef std::pair <std::string, std::vector <Shape_t> > Contact_t;
+
+        std::vector <Obstacle> obstacles;
+        std::vector <Contact_t> contacts;
+        std::vector <Frame> handles;
+        std::vector <Frame> grippers;
+
+        /// Extract the model from a device loaded with joint "anchor".
+        static EnvironmentModel fromDevice (const DevicePtr_t& object);
+
+        /// Add the obstacles and contacts to the problem solver and the
+        /// handles and grippers to its robot.
+        ///
+        /// \param merge whether the meshes are merged into a single
+        ///        obstacle, named prefix + mergedName, used for collision
+        ///        checking. Each mesh is still added under its name, for
+        ///        distance computation and queries by name, but is not
+        ///        checked for collision. Other geometries are not merged.
+        ///        The merged obstacle is a MergedMesh.
+        void insert (const ProblemSolverPtr_t& problemSolver,
+            const DevicePtr_t& robot, const std::string& prefix,
+            bool merge = false) const;
+
+        /// Name of the merged obstacle, without prefix.
+        static const std::string mergedName;
+      }; // struct EnvironmentModel
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_ENVIRONMENT_MODEL_HH
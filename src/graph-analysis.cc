@@ -0,0 +1,170 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "graph-analysis.hh"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <stdexcept>
+
+#include <hpp/util/debug.hh>
+#include <hpp/util/pointer.hh>
+
+#include <hpp/core/configuration-shooter.hh>
+
+#include <hpp/manipulation/constraint-set.hh>
+#include <hpp/manipulation/problem.hh>
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/graph/edge.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/state.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        typedef std::set <graph::StatePtr_t> StateSet_t;
+
+        /// States reached from the given ones through the edges, taken
+        /// forward or backward.
+        StateSet_t reach (const GraphAnalysis::States_t& from,
+            const GraphAnalysis::Edges_t& edges, bool forward)
+        {
+          StateSet_t reached (from.begin (), from.end ());
+          std::vector <graph::StatePtr_t> queue (from.begin (), from.end ());
+          while (!queue.empty ()) {
+            graph::StatePtr_t s = queue.back ();
+            queue.pop_back ();
+            for (std::size_t i = 0; i < edges.size (); ++i) {
+              graph::StatePtr_t a = edges[i]->from (), b = edges[i]->to ();
+              if (!forward) std::swap (a, b);
+              if (a == s && reached.insert (b).second) queue.push_back (b);
+            }
+          }
+          return reached;
+        }
+
+        GraphAnalysis::States_t statesOf (const graph::GraphPtr_t& graph,
+            const core::Configurations_t& configs)
+        {
+          GraphAnalysis::States_t states;
+          for (std::size_t i = 0; i < configs.size (); ++i)
+            states.push_back (graph->getState (*configs[i]));
+          return states;
+        }
+      }
+
+      GraphAnalysis GraphAnalysis::analyze
+      (const ProblemSolverPtr_t& problemSolver, States_t initStates,
+       States_t goalStates, std::size_t probes)
+      {
+        const graph::GraphPtr_t& graph = problemSolver->constraintGraph ();
+        if (!graph) throw std::runtime_error ("You should create the graph");
+        const ProblemPtr_t& problem = problemSolver->problem ();
+        if (initStates.empty ()) {
+          if (!problem->initConfig ())
+            throw std::runtime_error ("No initial state nor configuration");
+          initStates.push_back (graph->getState (*problem->initConfig ()));
+        }
+        if (goalStates.empty ())
+          goalStates = statesOf (graph, problem->goalConfigs ());
+
+        States_t states;
+        Edges_t edges;
+        for (std::size_t i = 0; i < graph->nbComponents (); ++i) {
+          graph::GraphComponentPtr_t c = graph->get (i).lock ();
+          if (!c) continue;
+          graph::StatePtr_t s = HPP_DYNAMIC_PTR_CAST (graph::State, c);
+          graph::EdgePtr_t e = HPP_DYNAMIC_PTR_CAST (graph::Edge, c);
+          if (s) states.push_back (s);
+          else if (e) edges.push_back (e);
+        }
+
+        GraphAnalysis result;
+        StateSet_t emptyStates;
+        Edges_t usable;
+        if (probes > 0) {
+          core::ConfigurationShooterPtr_t shooter =
+            problem->configurationShooter ();
+          std::map <graph::StatePtr_t, std::vector <Configuration_t> > samples;
+          for (std::size_t i = 0; i < states.size (); ++i) {
+            ConstraintSetPtr_t constraint = graph->configConstraint (states[i]);
+            std::vector <Configuration_t>& q = samples [states[i]];
+            for (std::size_t j = 0; j < probes; ++j) {
+              ConfigurationPtr_t config = shooter->shoot ();
+              if (constraint->apply (*config)) q.push_back (*config);
+            }
+            if (q.empty ()) emptyStates.insert (states[i]);
+          }
+          for (std::size_t i = 0; i < edges.size (); ++i) {
+            const std::vector <Configuration_t>& from =
+              samples [edges[i]->from ()];
+            bool success = false;
+            for (std::size_t j = 0; j < probes && !from.empty () && !success;
+                ++j) {
+              ConfigurationPtr_t config = shooter->shoot ();
+              success = edges[i]->applyConstraints (from [j % from.size ()],
+                  *config);
+            }
+            if (success) usable.push_back (edges[i]);
+            else result.emptyEdges.push_back (edges[i]);
+          }
+        } else {
+          usable = edges;
+        }
+
+        const StateSet_t forward = reach (initStates, usable, true);
+        const StateSet_t backward = reach (goalStates, usable, false);
+        StateSet_t dead;
+        for (std::size_t i = 0; i < states.size (); ++i) {
+          const graph::StatePtr_t& s = states[i];
+          if (emptyStates.count (s) || !forward.count (s)
+              || (!goalStates.empty () && !backward.count (s))) {
+            dead.insert (s);
+            result.deadStates.push_back (s);
+          }
+        }
+        for (std::size_t i = 0; i < edges.size (); ++i) {
+          if (dead.count (edges[i]->from ()) || dead.count (edges[i]->to ())
+              || std::find (usable.begin (), usable.end (), edges[i])
+              == usable.end ())
+            result.prunedEdges.push_back (edges[i]);
+        }
+        hppDout (info, result.deadStates.size () << " dead states, "
+            << result.emptyEdges.size () << " empty edges, "
+            << result.prunedEdges.size () << " pruned edges");
+        return result;
+      }
+
+      std::size_t GraphAnalysis::disable () const
+      {
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < prunedEdges.size (); ++i) {
+          const graph::EdgePtr_t& e = prunedEdges[i];
+          // Edges of waypoint edges are not neighbors of their state.
+          const graph::Edges_t neighbors = e->from ()->neighborEdges ();
+          if (std::find (neighbors.begin (), neighbors.end (), e)
+              == neighbors.end ())
+            continue;
+          e->from ()->updateWeight (e, 0);
+          ++n;
+        }
+        return n;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,65 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_GRAPH_ANALYSIS_HH
+# define HPP_MANIPULATION_CORBA_GRAPH_ANALYSIS_HH
+
+# include <vector>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// States and edges of a constraint graph that cannot be part of a
+      /// solution.
+      ///
+      /// Each state is probed by projecting random configurations on its
+      /// constraints, and each edge by projecting random configurations on
+      /// the leaves of configurations found in its initial state. A state
+      /// or an edge without any successful projection is empty. States are
+      /// dead if they are empty, not reachable from an initial state, or
+      /// if no goal state is reachable from them, through edges that are
+      /// not empty.
+      struct GraphAnalysis
+      {
+        typedef std::vector <graph::StatePtr_t> States_t;
+        typedef std::vector <graph::EdgePtr_t> Edges_t;
+
+        States_t deadStates;
+        Edges_t emptyEdges;
+        /// Empty edges and edges from or to a dead state.
+        Edges_t prunedEdges;
+
+        /// \param initStates, goalStates if empty, the states of the
+        ///        initial and goal configurations of the problem. Without
+        ///        goal, states are not checked for reaching a goal.
+        /// \param probes number of random configurations per state and per
+        ///        edge, 0 to skip the probes.
+        static GraphAnalysis analyze (const ProblemSolverPtr_t& problemSolver,
+            States_t initStates, States_t goalStates, std::size_t probes);
+
+        /// Set the weight of the pruned edges to 0, so that they are
+        /// never selected to extend the roadmap.
+        /// \return the number of edges disabled.
+        std::size_t disable () const;
+      }; // struct GraphAnalysis
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_GRAPH_ANALYSIS_HH
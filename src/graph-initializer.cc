@@ -0,0 +1,175 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "graph-initializer.hh"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <hpp/util/debug.hh>
+#include <hpp/util/pointer.hh>
+
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/graph/edge.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/graph-component.hh>
+#include <hpp/manipulation/graph/state.hh>
+
+#include "metrics.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        struct Task {
+          graph::GraphComponentPtr_t component;
+          value_type seconds;
+          std::string error;
+        };
+        typedef std::vector <Task> Tasks_t;
+
+        /// Initialize the components [next, end), shared with other
+        /// workers.
+        struct Initializer {
+          Tasks_t& tasks;
+          std::size_t& next;
+          boost::mutex& mutex;
+
+          void operator() ()
+          {
+            while (true) {
+              std::size_t i;
+              {
+                boost::mutex::scoped_lock lock (mutex);
+                if (next >= tasks.size ()) return;
+                i = next++;
+              }
+              const ServerMetrics::value_type start = ServerMetrics::now ();
+              try {
+                tasks[i].component->initialize ();
+              } catch (const std::exception& e) {
+                tasks[i].error = e.what ();
+              }
+              tasks[i].seconds =
+                1e-9 * (double) (ServerMetrics::now () - start);
+            }
+          }
+        };
+
+        /// Initialize the tasks, the calling thread being one of the
+        /// workers, and record their timings.
+        /// \throw std::runtime_error with the failure of the first task.
+        void run (Tasks_t& tasks, std::size_t threads,
+            GraphInitializer::Timings_t& timings)
+        {
+          std::size_t next = 0;
+          boost::mutex mutex;
+          Initializer initializer = { tasks, next, mutex };
+          threads = std::min (threads, tasks.size ());
+          boost::thread_group workers;
+          for (std::size_t i = 1; i < threads; ++i)
+            workers.create_thread (initializer);
+          initializer ();
+          workers.join_all ();
+
+          for (std::size_t i = 0; i < tasks.size (); ++i) {
+            const graph::GraphComponentPtr_t& c = tasks[i].component;
+            if (!tasks[i].error.empty ()) {
+              std::ostringstream oss;
+              oss << "Failed to initialize " << c->name () << " (id "
+                << c->id () << "): " << tasks[i].error;
+              throw std::runtime_error (oss.str ());
+            }
+            GraphInitializer::Timing timing;
+            timing.id = c->id ();
+            timing.name = c->name ();
+            timing.seconds = tasks[i].seconds;
+            timings.push_back (timing);
+          }
+        }
+
+        bool byId (const GraphInitializer::Timing& a,
+            const GraphInitializer::Timing& b)
+        {
+          return a.id < b.id;
+        }
+      }
+
+      void GraphInitializer::prepare (const ProblemSolverPtr_t& problemSolver)
+      {
+        const graph::GraphPtr_t graph = problemSolver->constraintGraph ();
+        if (!graph) throw std::runtime_error ("The graph is not defined.");
+
+        // The components read the steering method and the registered
+        // constraints.
+        problemSolver->initSteeringMethod ();
+        graph->clearConstraintsAndComplement ();
+        for (std::size_t i = 0;
+            i < problemSolver->constraintsAndComplements.size (); ++i) {
+          const ConstraintAndComplement_t& c =
+            problemSolver->constraintsAndComplements [i];
+          graph->registerConstraints (c.constraint, c.complement, c.both);
+        }
+      }
+
+      GraphInitializer::Timings_t GraphInitializer::initialize
+      (const ProblemSolverPtr_t& problemSolver, std::size_t threads)
+      {
+        prepare (problemSolver);
+        const graph::GraphPtr_t graph = problemSolver->constraintGraph ();
+
+        // The inner edges of the waypoint edges are initialized by them.
+        std::set <std::size_t> inner;
+        for (std::size_t i = 0; i < graph->nbComponents (); ++i) {
+          graph::WaypointEdgePtr_t we = HPP_DYNAMIC_PTR_CAST
+            (graph::WaypointEdge, graph->get (i).lock ());
+          if (!we) continue;
+          for (std::size_t j = 0; j <= we->nbWaypoints (); ++j)
+            if (graph::EdgePtr_t e = we->waypoint (j)) inner.insert (e->id ());
+        }
+
+        Tasks_t states, edges;
+        for (std::size_t i = 0; i < graph->nbComponents (); ++i) {
+          if (i == graph->id () || inner.count (i)) continue;
+          graph::GraphComponentPtr_t c = graph->get (i).lock ();
+          if (!c || HPP_DYNAMIC_PTR_CAST (graph::LevelSetEdge, c)) continue;
+          Task task;
+          task.component = c;
+          task.seconds = 0;
+          if (HPP_DYNAMIC_PTR_CAST (graph::Edge, c)) edges.push_back (task);
+          else states.push_back (task);
+        }
+
+        if (threads == 0)
+          threads = std::max (boost::thread::hardware_concurrency (), 1u);
+        Timings_t timings;
+        run (states, threads, timings);
+        run (edges, threads, timings);
+        problemSolver->initConstraintGraph ();
+
+        std::sort (timings.begin (), timings.end (), byId);
+        hppDout (info, "Initialized " << timings.size ()
+            << " components on " << threads << " threads");
+        return timings;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
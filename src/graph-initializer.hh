@@ -0,0 +1,81 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_GRAPH_INITIALIZER_HH
+# define HPP_MANIPULATION_CORBA_GRAPH_INITIALIZER_HH
+
+# include <string>
+# include <vector>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Initialization of the components of a constraint graph on
+      /// several threads.
+      ///
+      /// The steering method of the problem is initialized and the
+      /// constraints and complements are registered in the graph first, as
+      /// by ProblemSolver::initConstraintGraph. The states are then
+      /// initialized in parallel, then the edges. Each state and edge builds
+      /// its own constraint sets, projectors, steering method and path
+      /// validation, and only reads the objects it shares with the others:
+      /// the device, the steering method of the problem, the path
+      /// validation factory and the registered constraints.
+      ///
+      /// The components that modify shared objects are not initialized in
+      /// parallel. A waypoint edge initializes its inner edges, which are
+      /// not tasks of their own. The level set edges, which register their
+      /// histogram in the graph, are initialized on the calling thread by
+      /// ProblemSolver::initConstraintGraph, which ends the initialization
+      /// and skips the components already initialized.
+      ///
+      /// Ids are given to the components when they are created, so they do
+      /// not depend on the order of initialization.
+      struct GraphInitializer
+      {
+        struct Timing {
+          std::size_t id;
+          std::string name;
+          value_type seconds;
+        };
+        typedef std::vector <Timing> Timings_t;
+
+        /// Initialize the steering method of a problem solver and register
+        /// its constraints and complements in its graph, as done by
+        /// ProblemSolver::initConstraintGraph before the components are
+        /// initialized.
+        /// \throw std::runtime_error if the graph is not defined.
+        static void prepare (const ProblemSolverPtr_t& problemSolver);
+
+        /// Initialize the constraint graph of a problem solver.
+        /// \param threads number of threads, 0 for the number of cores.
+        /// \return the timings of the components initialized in parallel,
+        ///         sorted by id. The time of a waypoint edge includes the
+        ///         one of its inner edges.
+        /// \throw std::runtime_error with the message of the failure of the
+        ///        state of smallest id, or else of the edge of smallest id,
+        ///        whatever the scheduling.
+        static Timings_t initialize (const ProblemSolverPtr_t& problemSolver,
+            std::size_t threads);
+      }; // struct GraphInitializer
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_GRAPH_INITIALIZER_HH
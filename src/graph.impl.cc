@@ -42,7 +42,14 @@
 
 #include <hpp/corbaserver/manipulation/server.hh>
 
+#include "graph-analysis.hh"
+#include "metrics.hh"
+#include "projection-cache.hh"
+#include "scene-assemblies.hh"
+#include "scheduler.hh"
+#include "solve-jobs.hh"
 #include "tools.hh"
+#include "versions.hh"
 
 namespace hpp {
   namespace manipulation {
@@ -100,6 +107,48 @@ namespace hpp {
           out.handles_  = toStringVector (in.handles );
           out.link_ = in.link;
         }
+
+        GraspFeasibilitySeq* toGraspFeasibilitySeq
+        (const GraspFeasibility::Grasps_t& grasps)
+        {
+          GraspFeasibilitySeq* out = new GraspFeasibilitySeq ();
+          out->length ((ULong) grasps.size ());
+          for (std::size_t i = 0; i < grasps.size (); ++i) {
+            hpp::corbaserver::manipulation::GraspFeasibility& g =
+              (*out) [(ULong) i];
+            g.gripper = grasps[i].gripper.c_str ();
+            g.handle = grasps[i].handle.c_str ();
+            g.trials = (ULong) grasps[i].trials;
+            g.successes = (ULong) grasps[i].successes;
+            g.witnesses.length ((ULong) grasps[i].witnesses.size ());
+            for (std::size_t j = 0; j < grasps[i].witnesses.size (); ++j) {
+              const Configuration_t& q = grasps[i].witnesses[j];
+              floatSeq& w = g.witnesses [(ULong) j];
+              w.length ((ULong) q.size ());
+              for (size_type k = 0; k < q.size (); ++k) w [(ULong) k] = q[k];
+            }
+          }
+          return out;
+        }
+
+        GraspFeasibility::Grasps_t toGrasps (const GraspFeasibilitySeq& in)
+        {
+          GraspFeasibility::Grasps_t grasps (in.length ());
+          for (ULong i = 0; i < in.length (); ++i) {
+            grasps[i].gripper = in[i].gripper;
+            grasps[i].handle = in[i].handle;
+            grasps[i].trials = in[i].trials;
+            grasps[i].successes = in[i].successes;
+            grasps[i].witnesses.resize (in[i].witnesses.length ());
+            for (ULong j = 0; j < in[i].witnesses.length (); ++j) {
+              const floatSeq& w = in[i].witnesses[j];
+              Configuration_t& q = grasps[i].witnesses[j];
+              q.resize (w.length ());
+              for (ULong k = 0; k < w.length (); ++k) q[k] = w[k];
+            }
+          }
+          return grasps;
+        }
       }
 
       std::vector <std::string>
@@ -118,14 +167,55 @@ namespace hpp {
       }
 
       Graph::Graph () :
-        server_ (0x0)
+        server_ (0x0), initializeThreads_ (0)
       {}
 
+      CORBA::Boolean Graph::_dispatch (omniCallHandle& handle)
+      {
+        server_->solveJobs ().checkIdle (dynamic_cast <ProblemSolverPtr_t>
+            (server_->problemSolverMap ()->selected ()), "Graph",
+            handle.operation_name ());
+        server_->sceneAssemblies ().checkAllowed
+          (server_->problemSolverMap ()->selected_, "Graph",
+           handle.operation_name ());
+        // Time spent waiting for admission is not part of the metrics of
+        // the operation.
+        impl::Scheduler::Ticket ticket (server_->scheduler (), "Graph",
+            handle.operation_name ());
+        impl::ServerMetrics::Call call (server_->metrics (), "Graph",
+            handle.operation_name ());
+        // Destroyed before call, so that the metrics include the update.
+        impl::Versions::Update update (*server_, "Graph",
+            handle.operation_name ());
+        try {
+          CORBA::Boolean found =
+            POA_hpp::corbaserver::manipulation::Graph::_dispatch (handle);
+          if (!found) {
+            call.discard ();
+            update.discard ();
+          }
+          return found;
+        } catch (...) {
+          call.failed ();
+          throw;
+        }
+      }
+
       ProblemSolverPtr_t Graph::problemSolver ()
       {
         return server_->problemSolver();
       }
 
+      const std::string& Graph::selectedProblem ()
+      {
+        return server_->problemSolverMap ()->selected_;
+      }
+
+      Versions::value_type Graph::robotVersion ()
+      {
+        return server_->versions ().get (selectedProblem ()).robot;
+      }
+
       graph::GraphPtr_t Graph::graph (bool throwIfNull)
       {
         graph::GraphPtr_t g = problemSolver()->constraintGraph();
@@ -342,41 +432,128 @@ namespace hpp {
         return (Long) nb;
       }
 
+      graph::StatePtr_t Graph::stateOrAny (Long stateId)
+      {
+        if (stateId == -1) return graph::StatePtr_t ();
+        return getComp <graph::State> ((ID) stateId, true);
+      }
+
+      core::ConnectedComponentPtr_t Graph::connectedComponentOrAny (Long rank)
+      {
+        if (rank == -1) return core::ConnectedComponentPtr_t ();
+        const core::ConnectedComponents_t& ccs =
+          problemSolver()->roadmap ()->connectedComponents();
+        if (rank < 0 || (std::size_t) rank >= ccs.size ()) {
+          HPP_THROW (Error, "Wrong connected component rank: " << rank
+              << ", number of connected components: " << ccs.size ());
+        }
+        core::ConnectedComponents_t::const_iterator it = ccs.begin ();
+        std::advance (it, rank);
+        return *it;
+      }
+
+      intSeq* Graph::neighbours (const RoadmapIndex::Neighbours_t& n,
+          floatSeqSeq_out configs, floatSeq_out distances)
+      {
+        intSeq_var ranks = new intSeq ();
+        floatSeqSeq_var q = new floatSeqSeq ();
+        floatSeq_var d = new floatSeq ();
+        ranks->length ((ULong) n.size ());
+        q->length ((ULong) n.size ());
+        d->length ((ULong) n.size ());
+        for (std::size_t i = 0; i < n.size (); ++i) {
+          const Configuration_t& config = *n[i].node->configuration ();
+          ranks[(ULong) i] = (Long) n[i].rank;
+          q[(ULong) i].length ((ULong) config.size ());
+          for (size_type j = 0; j < config.size (); ++j)
+            q[(ULong) i][(ULong) j] = config[j];
+          d[(ULong) i] = n[i].distance;
+        }
+        configs = q._retn ();
+        distances = d._retn ();
+        return ranks._retn ();
+      }
+
+      intSeq* Graph::getNearestNodesInState (Long stateId,
+          Long connectedComponent, const hpp::floatSeq& config,
+          CORBA::ULong k, floatSeqSeq_out configs, floatSeq_out distances)
+        throw (hpp::Error)
+      {
+        graph::StatePtr_t state = stateOrAny (stateId);
+        DevicePtr_t robot = getRobotOrThrow (problemSolver());
+        try {
+          Configuration_t q (floatSeqToConfig (robot, config, true));
+          return neighbours (server_->roadmapIndex ().nearest
+              (problemSolver(), selectedProblem (), state,
+               connectedComponentOrAny (connectedComponent), q, k),
+              configs, distances);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      intSeq* Graph::getNodesInStateWithinRadius (Long stateId,
+          Long connectedComponent, const hpp::floatSeq& config,
+          CORBA::Double radius, floatSeqSeq_out configs,
+          floatSeq_out distances)
+        throw (hpp::Error)
+      {
+        graph::StatePtr_t state = stateOrAny (stateId);
+        DevicePtr_t robot = getRobotOrThrow (problemSolver());
+        try {
+          Configuration_t q (floatSeqToConfig (robot, config, true));
+          return neighbours (server_->roadmapIndex ().withinRadius
+              (problemSolver(), selectedProblem (), state,
+               connectedComponentOrAny (connectedComponent), q, radius),
+              configs, distances);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
       bool Graph::getConfigProjectorStats (ID elmt, ConfigProjStat_out config,
           ConfigProjStat_out path)
         throw (hpp::Error)
       {
         graph::StatePtr_t state = getComp <graph::State> (elmt, false);
         graph::EdgePtr_t edge = getComp <graph::Edge> (elmt, false);
-        if (state) {
-          ConfigProjectorPtr_t proj =
-            graph()->configConstraint (state)->configProjector ();
-          if (proj) {
-            config.success = (Long) proj->statistics().nbSuccess();
-            config.error = (Long) proj->statistics().nbFailure();
-            config.nbObs = (Long) proj->statistics().numberOfObservations();
-          }
-          path.success = 0;
-          path.error = 0;
-          path.nbObs = 0;
-          return true;
-        } else if (edge) {
-          ConfigProjectorPtr_t proj =
-            graph()->configConstraint (edge)->configProjector ();
-          if (proj) {
-            config.success = (Long) proj->statistics().nbSuccess();
-            config.error = (Long) proj->statistics().nbFailure();
-            config.nbObs = (Long) proj->statistics().numberOfObservations();
-          }
-          proj = graph()->pathConstraint (edge)->configProjector ();
-          if (proj) {
-            path.success = (Long) proj->statistics().nbSuccess();
-            path.error = (Long) proj->statistics().nbFailure();
-            path.nbObs = (Long) proj->statistics().numberOfObservations();
+        try {
+          if (state) {
+            LazyComponents::Use use (server_->lazyComponents (),
+                selectedProblem (), graph (), state);
+            ConfigProjectorPtr_t proj =
+              graph()->configConstraint (state)->configProjector ();
+            if (proj) {
+              config.success = (Long) proj->statistics().nbSuccess();
+              config.error = (Long) proj->statistics().nbFailure();
+              config.nbObs = (Long) proj->statistics().numberOfObservations();
+            }
+            path.success = 0;
+            path.error = 0;
+            path.nbObs = 0;
+            return true;
+          } else if (edge) {
+            LazyComponents::Use use (server_->lazyComponents (),
+                selectedProblem (), graph (), edge);
+            ConfigProjectorPtr_t proj =
+              graph()->configConstraint (edge)->configProjector ();
+            if (proj) {
+              config.success = (Long) proj->statistics().nbSuccess();
+              config.error = (Long) proj->statistics().nbFailure();
+              config.nbObs = (Long) proj->statistics().numberOfObservations();
+            }
+            proj = graph()->pathConstraint (edge)->configProjector ();
+            if (proj) {
+              path.success = (Long) proj->statistics().nbSuccess();
+              path.error = (Long) proj->statistics().nbFailure();
+              path.nbObs = (Long) proj->statistics().numberOfObservations();
+            }
+            return true;
+          } else {
+            throw Error ("The ID does not exist.");
           }
-          return true;
-        } else {
-          throw Error ("The ID does not exist.");
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
         }
         return false;
       }
@@ -591,8 +768,20 @@ namespace hpp {
         DevicePtr_t robot = getRobotOrThrow (problemSolver());
         try {
           Configuration_t config (floatSeqToConfig (robot, dofArray, true));
-          graph::StatePtr_t state = graph()->getState (config);
-          output = (Long) state->id();
+          // As graph::Graph::getState, but initializes the states one at a
+          // time, until one contains the configuration.
+          const graph::States_t states (graph()->stateSelector ()->getStates ());
+          for (graph::States_t::const_iterator it = states.begin ();
+              it != states.end (); ++it) {
+            LazyComponents::Use use (server_->lazyComponents (),
+                selectedProblem (), graph (), *it);
+            if ((*it)->contains (config)) {
+              output = (Long) (*it)->id();
+              return;
+            }
+          }
+          HPP_THROW (std::logic_error, "A configuration has no node: "
+              << config.transpose ());
         } catch (std::exception& e) {
           throw Error (e.what());
         }
@@ -607,9 +796,33 @@ namespace hpp {
 	try {
 	  vector_t err;
           Configuration_t config (floatSeqToConfig (robot, dofArray, true));
-	  bool res = graph()->getConfigErrorForState (config, state, err);
-	  error = vectorToFloatSeq(err);
-	  return res;
+          ProjectionCache& cache = server_->projectionCache ();
+          if (!cache.enabled ()) {
+            LazyComponents::Use use (server_->lazyComponents (),
+                selectedProblem (), graph (), state);
+            bool res = graph()->getConfigErrorForState (config, state, err);
+            error = vectorToFloatSeq(err);
+            return res;
+          }
+          Versions::Stamps stamps = server_->versions ().get
+            (selectedProblem ());
+          // The projectors of the states are created with the parameters
+          // of the graph.
+          ProjectionCache::Key key = cache.key (ProjectionCache::STATE_ERROR,
+              (std::size_t) nodeId, config, vector_t (),
+              graph()->errorThreshold (),
+              (std::size_t) graph()->maxIterations ());
+          ProjectionCache::Result result;
+          if (!cache.find (selectedProblem (), stamps, key, result)) {
+            LazyComponents::Use use (server_->lazyComponents (),
+                selectedProblem (), graph (), state);
+            result.success = graph()->getConfigErrorForState
+              (config, state, result.value);
+            result.residualError = result.value.norm ();
+            cache.insert (selectedProblem (), stamps, key, result);
+          }
+          error = vectorToFloatSeq(result.value);
+          return result.success;
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -629,6 +842,8 @@ namespace hpp {
 	      ->innerSteeringMethod()) {
 	    problemSolver ()->initSteeringMethod ();
 	  }
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), edge);
 	  vector_t err;
           Configuration_t config (floatSeqToConfig (robot, dofArray, true));
 	  bool res = graph()->getConfigErrorForEdge (config, edge, err);
@@ -659,6 +874,8 @@ namespace hpp {
 	      ->innerSteeringMethod()) {
 	    problemSolver ()->initSteeringMethod ();
 	  }
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), edge);
 	  vector_t err;
           Configuration_t leafConfig (floatSeqToConfig (robot, leafDofArray, true));
           Configuration_t config (floatSeqToConfig (robot, dofArray, true));
@@ -691,6 +908,8 @@ namespace hpp {
 	      ->innerSteeringMethod()) {
 	    problemSolver ()->initSteeringMethod ();
 	  }
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), edge);
 	  vector_t err;
           Configuration_t leafConfig (floatSeqToConfig (robot, leafDofArray, true));
           Configuration_t config (floatSeqToConfig (robot, dofArray, true));
@@ -712,30 +931,48 @@ namespace hpp {
       (hpp::ID nodeId, CORBA::String_out constraints) throw (Error)
       {
 	graph::StatePtr_t state = getComp <graph::State> (nodeId);
-	ConstraintSetPtr_t cs (graph()->configConstraint (state));
-	std::ostringstream oss;
-	oss << (*cs);
-	constraints = oss.str ().c_str ();
+	try {
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), state);
+	  ConstraintSetPtr_t cs (graph()->configConstraint (state));
+	  std::ostringstream oss;
+	  oss << (*cs);
+	  constraints = oss.str ().c_str ();
+	} catch (const std::exception& exc) {
+	  throw Error (exc.what ());
+	}
       }
 
       void Graph::displayEdgeTargetConstraints
       (hpp::ID edgeId, CORBA::String_out constraints) throw (Error)
       {
 	graph::EdgePtr_t edge = getComp <graph::Edge> (edgeId);
-	ConstraintSetPtr_t cs (graph()->configConstraint (edge));
-	std::ostringstream oss;
-	oss << (*cs);
-	constraints = oss.str ().c_str ();
+	try {
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), edge);
+	  ConstraintSetPtr_t cs (graph()->configConstraint (edge));
+	  std::ostringstream oss;
+	  oss << (*cs);
+	  constraints = oss.str ().c_str ();
+	} catch (const std::exception& exc) {
+	  throw Error (exc.what ());
+	}
       }
 
       void Graph::displayEdgeConstraints
       (hpp::ID edgeId, CORBA::String_out constraints) throw (Error)
       {
 	graph::EdgePtr_t edge = getComp <graph::Edge> (edgeId);
-	ConstraintSetPtr_t cs (graph()->pathConstraint (edge));
-	std::ostringstream oss;
-	oss << (*cs);
-	constraints = oss.str ().c_str ();
+	try {
+	  LazyComponents::Use use (server_->lazyComponents (),
+	      selectedProblem (), graph (), edge);
+	  ConstraintSetPtr_t cs (graph()->pathConstraint (edge));
+	  std::ostringstream oss;
+	  oss << (*cs);
+	  constraints = oss.str ().c_str ();
+	} catch (const std::exception& exc) {
+	  throw Error (exc.what ());
+	}
       }
 
        void Graph::getNodesConnectedByEdge
@@ -819,10 +1056,14 @@ namespace hpp {
 	  const Rules& rulesList)
         throw (hpp::Error)
       {
-	std::vector<graph::helper::Rule> rules(rulesList.length());
+	// Unreachable grasps are forbidden first.
+	std::vector<graph::helper::Rule> rules = GraspFeasibility::rules
+          (graspFeasibility_.get (selectedProblem (), robotVersion ()));
+	const std::size_t nForbidden = rules.size ();
+	rules.resize (nForbidden + rulesList.length());
 
 	for (ULong i = 0; i < rulesList.length(); ++i) {
-          setRule (rulesList[i], rules[i]);
+          setRule (rulesList[i], rules[nForbidden + i]);
 	}
         try {
           graph::GraphPtr_t g = graph::helper::graphBuilder (
@@ -845,6 +1086,121 @@ namespace hpp {
         }
       }
 
+      GraspFeasibilitySeq* Graph::computeGraspFeasibility
+      (const Names_t& grippers, const Names_t& handles, ULong trials,
+       ULong maxWitnesses)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          std::vector <std::string> g = toStringVector (grippers),
+            h = toStringVector (handles);
+          if (g.empty ()) g = robot->grippers.getKeys
+            <std::vector <std::string> > ();
+          if (h.empty ()) h = robot->handles.getKeys
+            <std::vector <std::string> > ();
+
+          GraspFeasibility::Grasps_t grasps;
+          for (std::size_t i = 0; i < g.size (); ++i)
+            for (std::size_t j = 0; j < h.size (); ++j)
+              grasps.push_back (GraspFeasibility::evaluate (problemSolver(),
+                    g[i], h[j], trials, maxWitnesses));
+          graspFeasibility_.update (selectedProblem (), robotVersion (),
+              grasps);
+          return toGraspFeasibilitySeq (grasps);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      void Graph::setGraspFeasibility (const GraspFeasibilitySeq& table)
+        throw (hpp::Error)
+      {
+        graspFeasibility_.set (selectedProblem (), robotVersion (),
+            toGrasps (table));
+      }
+
+      GraspFeasibilitySeq* Graph::getGraspFeasibility ()
+        throw (hpp::Error)
+      {
+        return toGraspFeasibilitySeq
+          (graspFeasibility_.get (selectedProblem (), robotVersion ()));
+      }
+
+      Long Graph::seedRoadmapWithGraspWitnesses ()
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          graph::GraphPtr_t g = graph ();
+          server_->lazyComponents ().complete (selectedProblem (),
+              problemSolver ());
+          GraspFeasibility::Grasps_t grasps =
+            graspFeasibility_.get (selectedProblem (), robotVersion ());
+          // Every witness must lie in a state of the graph, so that either
+          // all of them are added or none.
+          std::vector <ConfigurationPtr_t> witnesses;
+          for (std::size_t i = 0; i < grasps.size (); ++i) {
+            for (std::size_t j = 0; j < grasps[i].witnesses.size (); ++j) {
+              ConfigurationPtr_t q (new Configuration_t
+                  (grasps[i].witnesses[j]));
+              if (q->size () != robot->configSize ()) continue;
+              try {
+                g->getState (*q);
+              } catch (const std::exception& exc) {
+                HPP_THROW (std::runtime_error, "A witness of "
+                    << grasps[i].gripper << " grasps " << grasps[i].handle
+                    << " is in no state of the graph: " << exc.what ());
+              }
+              witnesses.push_back (q);
+            }
+          }
+          core::RoadmapPtr_t roadmap = problemSolver()->roadmap ();
+          for (std::size_t i = 0; i < witnesses.size (); ++i)
+            roadmap->addNode (witnesses[i]);
+          return (Long) witnesses.size ();
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      namespace {
+        template <typename Components>
+        hpp::IDseq* toIDseq (const Components& components)
+        {
+          hpp::IDseq* ids = new hpp::IDseq ();
+          ids->length ((ULong) components.size ());
+          for (std::size_t i = 0; i < components.size (); ++i)
+            (*ids) [(ULong) i] = (ID) components[i]->id ();
+          return ids;
+        }
+      }
+
+      hpp::IDseq* Graph::analyze (const hpp::IDseq& initStates,
+          const hpp::IDseq& goalStates, CORBA::ULong probes,
+          CORBA::Boolean disable, hpp::IDseq_out deadStates,
+          hpp::IDseq_out emptyEdges)
+        throw (hpp::Error)
+      {
+        GraphAnalysis::States_t init, goal;
+        for (ULong i = 0; i < initStates.length (); ++i)
+          init.push_back (getComp <graph::State> (initStates[i]));
+        for (ULong i = 0; i < goalStates.length (); ++i)
+          goal.push_back (getComp <graph::State> (goalStates[i]));
+        try {
+          server_->lazyComponents ().complete (selectedProblem (),
+              problemSolver ());
+          GraphAnalysis analysis = GraphAnalysis::analyze (problemSolver(),
+              init, goal, probes);
+          if (disable) analysis.disable ();
+          deadStates = toIDseq (analysis.deadStates);
+          emptyEdges = toIDseq (analysis.emptyEdges);
+          return toIDseq (analysis.prunedEdges);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
       void Graph::setWeight (ID edgeId, const Long weight)
         throw (hpp::Error)
       {
@@ -871,12 +1227,80 @@ namespace hpp {
         throw (hpp::Error)
       {
         try {
-          problemSolver ()->initConstraintGraph ();
+          std::size_t threads;
+          {
+            boost::mutex::scoped_lock lock (initializeMutex_);
+            threads = initializeThreads_;
+          }
+          LazyComponents& lazy = server_->lazyComponents ();
+          GraphInitializer::Timings_t times;
+          if (lazy.lazy (selectedProblem ())) {
+            lazy.defer (selectedProblem (), problemSolver (), threads);
+          } else {
+            lazy.forget (selectedProblem ());
+            times = GraphInitializer::initialize (problemSolver (), threads);
+          }
+          boost::mutex::scoped_lock lock (initializeMutex_);
+          initializeTimes_ = times;
+	} catch (const std::exception& exc) {
+	  throw Error (exc.what ());
+	}
+      }
+
+      void Graph::setInitializeThreads (CORBA::ULong threads)
+        throw (hpp::Error)
+      {
+        boost::mutex::scoped_lock lock (initializeMutex_);
+        initializeThreads_ = threads;
+      }
+
+      void Graph::getInitializeTimes (hpp::IDseq_out ids,
+          floatSeq_out seconds)
+        throw (hpp::Error)
+      {
+        boost::mutex::scoped_lock lock (initializeMutex_);
+        hpp::IDseq_var i = new hpp::IDseq ();
+        floatSeq_var s = new floatSeq ();
+        i->length ((ULong) initializeTimes_.size ());
+        s->length ((ULong) initializeTimes_.size ());
+        for (std::size_t k = 0; k < initializeTimes_.size (); ++k) {
+          i[(ULong) k] = (ID) initializeTimes_[k].id;
+          s[(ULong) k] = initializeTimes_[k].seconds;
+        }
+        ids = i._retn ();
+        seconds = s._retn ();
+      }
+
+      void Graph::setLazyInitialization (CORBA::Boolean lazy,
+          CORBA::ULong capacity)
+        throw (hpp::Error)
+      {
+        server_->lazyComponents ().configure (selectedProblem (), lazy,
+            capacity);
+      }
+
+      void Graph::completeInitialization ()
+        throw (hpp::Error)
+      {
+        try {
+          server_->lazyComponents ().complete (selectedProblem (),
+              problemSolver ());
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
       }
 
+      CORBA::ULong Graph::getLazyInitializationStats (CORBA::ULong& materialized,
+          CORBA::ULong& evicted)
+        throw (hpp::Error)
+      {
+        LazyComponents::Stats stats =
+          server_->lazyComponents ().stats (selectedProblem ());
+        materialized = (CORBA::ULong) stats.materialized;
+        evicted = (CORBA::ULong) stats.evicted;
+        return (CORBA::ULong) stats.resident;
+      }
+
       void Graph::getRelativeMotionMatrix (ID edgeId, intSeqSeq_out matrix)
         throw (hpp::Error)
       {
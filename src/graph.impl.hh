@@ -23,11 +23,19 @@
 # include "hpp/corbaserver/manipulation/fwd.hh"
 # include "hpp/corbaserver/manipulation/graph.hh"
 
+# include <boost/thread/mutex.hpp>
+
+# include "grasp-feasibility.hh"
+# include "graph-initializer.hh"
+# include "lazy-components.hh"
+# include "roadmap-index.hh"
+
 namespace hpp {
   namespace manipulation {
     namespace impl {
       using hpp::corbaserver::manipulation::Namess_t;
       using hpp::corbaserver::manipulation::Rules;
+      using hpp::corbaserver::manipulation::GraspFeasibilitySeq;
       using CORBA::Long;
 
       class Graph : public virtual POA_hpp::corbaserver::manipulation::Graph
@@ -39,6 +47,9 @@ namespace hpp {
             server_ = server;
           }
 
+          /// Record the statistics of the call in Server::metrics.
+          virtual CORBA::Boolean _dispatch (omniCallHandle& handle);
+
           virtual Long createGraph(const char* graphName)
             throw (hpp::Error);
 
@@ -83,6 +94,18 @@ namespace hpp {
           virtual Long getFrequencyOfNodeInRoadmap (ID nodeId, intSeq_out freqPerConnectedComponent)
             throw (hpp::Error);
 
+          virtual intSeq* getNearestNodesInState (Long stateId,
+              Long connectedComponent, const hpp::floatSeq& config,
+              CORBA::ULong k, floatSeqSeq_out configs,
+              floatSeq_out distances)
+            throw (hpp::Error);
+
+          virtual intSeq* getNodesInStateWithinRadius (Long stateId,
+              Long connectedComponent, const hpp::floatSeq& config,
+              CORBA::Double radius, floatSeqSeq_out configs,
+              floatSeq_out distances)
+            throw (hpp::Error);
+
           virtual bool getConfigProjectorStats (ID elmt, ConfigProjStat_out config,
               ConfigProjStat_out path)
             throw (hpp::Error);
@@ -221,6 +244,26 @@ namespace hpp {
 	      const Names_t& envNames, const Rules& rulesList)
             throw (hpp::Error);
 
+          virtual GraspFeasibilitySeq* computeGraspFeasibility
+            (const Names_t& grippers, const Names_t& handles,
+             CORBA::ULong trials, CORBA::ULong maxWitnesses)
+            throw (hpp::Error);
+
+          virtual void setGraspFeasibility (const GraspFeasibilitySeq& table)
+            throw (hpp::Error);
+
+          virtual GraspFeasibilitySeq* getGraspFeasibility ()
+            throw (hpp::Error);
+
+          virtual Long seedRoadmapWithGraspWitnesses ()
+            throw (hpp::Error);
+
+          virtual hpp::IDseq* analyze (const hpp::IDseq& initStates,
+              const hpp::IDseq& goalStates, CORBA::ULong probes,
+              CORBA::Boolean disable, hpp::IDseq_out deadStates,
+              hpp::IDseq_out emptyEdges)
+            throw (hpp::Error);
+
           virtual void setWeight (ID edgeId, const Long weight)
             throw (hpp::Error);
 
@@ -230,6 +273,24 @@ namespace hpp {
           virtual void initialize ()
             throw (hpp::Error);
 
+          virtual void setInitializeThreads (CORBA::ULong threads)
+            throw (hpp::Error);
+
+          virtual void getInitializeTimes (hpp::IDseq_out ids,
+              floatSeq_out seconds)
+            throw (hpp::Error);
+
+          virtual void setLazyInitialization (CORBA::Boolean lazy,
+              CORBA::ULong capacity)
+            throw (hpp::Error);
+
+          virtual void completeInitialization ()
+            throw (hpp::Error);
+
+          virtual CORBA::ULong getLazyInitializationStats
+            (CORBA::ULong& materialized, CORBA::ULong& evicted)
+            throw (hpp::Error);
+
           virtual void getRelativeMotionMatrix (ID edgeID, intSeqSeq_out matrix)
             throw (hpp::Error);
 
@@ -237,7 +298,21 @@ namespace hpp {
           template <typename T> boost::shared_ptr<T> getComp(ID id, bool throwIfWrongType = true);
           ProblemSolverPtr_t problemSolver();
           graph::GraphPtr_t graph(bool throwIfNull = true);
+          const std::string& selectedProblem ();
+          /// Version stamp of the robot of the selected problem.
+          Versions::value_type robotVersion ();
+          /// State of an id, NULL if id is -1.
+          graph::StatePtr_t stateOrAny (Long stateId);
+          /// Connected component of a rank, NULL if rank is -1.
+          core::ConnectedComponentPtr_t connectedComponentOrAny (Long rank);
+          /// Convert the results of the roadmap index.
+          static intSeq* neighbours (const RoadmapIndex::Neighbours_t& n,
+              floatSeqSeq_out configs, floatSeq_out distances);
           Server* server_;
+          GraspFeasibility graspFeasibility_;
+          boost::mutex initializeMutex_;
+          std::size_t initializeThreads_;
+          GraphInitializer::Timings_t initializeTimes_;
       }; // class Graph
     } // namespace impl
   } // namespace manipulation
@@ -0,0 +1,153 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "grasp-feasibility.hh"
+
+#include <stdexcept>
+
+#include <hpp/util/debug.hh>
+
+#include <hpp/pinocchio/gripper.hh>
+
+#include <hpp/core/config-projector.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/configuration-shooter.hh>
+#include <hpp/core/validation-report.hh>
+
+#include <hpp/manipulation/device.hh>
+#include <hpp/manipulation/handle.hh>
+#include <hpp/manipulation/problem.hh>
+#include <hpp/manipulation/problem-solver.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        /// Escape a name so that the rules match it literally.
+        std::string literal (const std::string& name)
+        {
+          static const std::string special (".[]{}()\\*+?|^$");
+          std::string result;
+          for (std::size_t i = 0; i < name.size (); ++i) {
+            if (special.find (name[i]) != std::string::npos) result += '\\';
+            result += name[i];
+          }
+          return result;
+        }
+      }
+
+      GraspFeasibility::Grasp GraspFeasibility::evaluate
+      (const ProblemSolverPtr_t& problemSolver, const std::string& gripper,
+       const std::string& handle, std::size_t trials,
+       std::size_t maxWitnesses)
+      {
+        DevicePtr_t robot = problemSolver->robot ();
+        if (!robot) throw std::runtime_error ("No robot loaded");
+        GripperPtr_t g = robot->grippers.get (gripper);
+        if (!g)
+          throw std::invalid_argument ("No gripper named " + gripper);
+        HandlePtr_t h = robot->handles.get (handle);
+        if (!h)
+          throw std::invalid_argument ("No handle named " + handle);
+
+        const std::string name (gripper + " grasps " + handle);
+        core::ConfigProjectorPtr_t projector = core::ConfigProjector::create
+          (robot, name, problemSolver->errorThreshold (),
+           problemSolver->maxIterProjection ());
+        projector->add (h->createGrasp (g, name));
+        const core::ProblemPtr_t& problem = problemSolver->problem ();
+        core::ConfigurationShooterPtr_t shooter =
+          problem->configurationShooter ();
+        core::ConfigValidationsPtr_t validations =
+          problem->configValidations ();
+
+        Grasp grasp;
+        grasp.gripper = gripper;
+        grasp.handle = handle;
+        for (; grasp.trials < trials; ++grasp.trials) {
+          ConfigurationPtr_t q = shooter->shoot ();
+          if (!projector->apply (*q)) continue;
+          core::ValidationReportPtr_t report;
+          if (!validations->validate (*q, report)) continue;
+          ++grasp.successes;
+          if (grasp.witnesses.size () < maxWitnesses)
+            grasp.witnesses.push_back (*q);
+        }
+        hppDout (info, name << ": " << grasp.successes << " / "
+            << grasp.trials);
+        return grasp;
+      }
+
+      std::vector <graph::helper::Rule> GraspFeasibility::rules
+      (const Grasps_t& grasps)
+      {
+        std::vector <graph::helper::Rule> result;
+        for (std::size_t i = 0; i < grasps.size (); ++i) {
+          if (grasps[i].trials == 0 || grasps[i].successes > 0) continue;
+          graph::helper::Rule r;
+          r.grippers_.push_back (literal (grasps[i].gripper));
+          r.handles_.push_back (literal (grasps[i].handle));
+          r.link_ = false;
+          result.push_back (r);
+        }
+        return result;
+      }
+
+      GraspFeasibility::Grasps_t& GraspFeasibility::table
+      (const std::string& problemName, Versions::value_type robot)
+      {
+        Table& t = tables_ [problemName];
+        if (t.robot != robot) {
+          t.robot = robot;
+          t.grasps.clear ();
+        }
+        return t.grasps;
+      }
+
+      void GraspFeasibility::set (const std::string& problemName,
+          Versions::value_type robot, const Grasps_t& grasps)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        table (problemName, robot) = grasps;
+      }
+
+      void GraspFeasibility::update (const std::string& problemName,
+          Versions::value_type robot, const Grasps_t& grasps)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Grasps_t& t = table (problemName, robot);
+        for (std::size_t i = 0; i < grasps.size (); ++i) {
+          std::size_t j = 0;
+          while (j < t.size () && (t[j].gripper != grasps[i].gripper
+                || t[j].handle != grasps[i].handle)) ++j;
+          if (j < t.size ()) t[j] = grasps[i];
+          else t.push_back (grasps[i]);
+        }
+      }
+
+      GraspFeasibility::Grasps_t GraspFeasibility::get
+      (const std::string& problemName, Versions::value_type robot) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        std::map <std::string, Table>::const_iterator it =
+          tables_.find (problemName);
+        if (it == tables_.end () || it->second.robot != robot)
+          return Grasps_t ();
+        return it->second.grasps;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_GRASP_FEASIBILITY_HH
+# define HPP_MANIPULATION_CORBA_GRASP_FEASIBILITY_HH
+
+# include <map>
+# include <string>
+# include <vector>
+
+# include <boost/thread/mutex.hpp>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/helper.hh>
+
+# include "versions.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Reachability of the grasps, estimated by sampling.
+      ///
+      /// Random configurations are projected on the grasp constraint of
+      /// a gripper and a handle, and the projections that satisfy the
+      /// configuration validations of the problem are counted. A grasp
+      /// that never succeeds is considered unreachable. Some successful
+      /// configurations are kept as witnesses.
+      ///
+      /// One table of grasps is stored per problem, with the version stamp
+      /// of the robot it was computed for. A table is discarded when the
+      /// robot of its problem changes.
+      class GraspFeasibility
+      {
+        public:
+          struct Grasp {
+            std::string gripper;
+            std::string handle;
+            std::size_t trials;
+            std::size_t successes;
+            std::vector <Configuration_t> witnesses;
+
+            Grasp () : trials (0), successes (0) {}
+          };
+          typedef std::vector <Grasp> Grasps_t;
+
+          /// Sample the grasp of a handle by a gripper.
+          /// \param trials number of random configurations projected,
+          /// \param maxWitnesses number of successful configurations kept.
+          static Grasp evaluate (const ProblemSolverPtr_t& problemSolver,
+              const std::string& gripper, const std::string& handle,
+              std::size_t trials, std::size_t maxWitnesses);
+
+          /// Rules of graph::helper::graphBuilder that forbid the states
+          /// with an unreachable grasp.
+          static std::vector <graph::helper::Rule> rules
+            (const Grasps_t& grasps);
+
+          /// Replace the grasps of a problem.
+          /// \param robot version stamp of the robot of the problem.
+          void set (const std::string& problemName,
+              Versions::value_type robot, const Grasps_t& grasps);
+
+          /// Add or replace grasps of a problem.
+          /// \param robot version stamp of the robot of the problem.
+          void update (const std::string& problemName,
+              Versions::value_type robot, const Grasps_t& grasps);
+
+          /// \param robot version stamp of the robot of the problem.
+          /// \return no grasp if the table was computed for another
+          ///         version of the robot.
+          Grasps_t get (const std::string& problemName,
+              Versions::value_type robot) const;
+
+        private:
+          struct Table {
+            Versions::value_type robot;
+            Grasps_t grasps;
+          };
+
+          /// Table of a problem, emptied if computed for another robot.
+          Grasps_t& table (const std::string& problemName,
+              Versions::value_type robot);
+
+          mutable boost::mutex mutex_;
+          std::map <std::string, Table> tables_;
+      }; // class GraspFeasibility
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_GRASP_FEASIBILITY_HH
@@ -0,0 +1,452 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+// Benchmark of the servants, called directly without going through the ORB.
+//
+// Usage: hpp-manipulation-benchmark [--repeat N] [--warmup N] [--seed S]
+//            [--joints N] [--filter substring] [--label text]
+//            [--output file.json]
+//
+// The results are written in JSON. Durations are in microseconds.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+
+#include <hpp/core/path-vector.hh>
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/corbaserver/problem-solver-map.hh>
+#include <hpp/corbaserver/manipulation/server.hh>
+
+#include "graph.impl.hh"
+#include "problem.impl.hh"
+#include "robot.impl.hh"
+#include "metrics.hh"
+#include "latency-histogram.hh"
+#include "benchmark-models.hh"
+
+typedef hpp::manipulation::Server ManipulationServer;
+typedef hpp::manipulation::ProblemSolver ProblemSolver;
+typedef hpp::manipulation::impl::LatencyHistogram LatencyHistogram;
+typedef hpp::manipulation::impl::ServerMetrics ServerMetrics;
+
+namespace bm = hpp::manipulation::benchmark;
+
+namespace {
+  struct Options {
+    std::size_t repeat;
+    std::size_t warmup;
+    unsigned int seed;
+    std::size_t nbJoints;
+    std::string filter;
+    std::string label;
+    std::string output;
+
+    Options () : repeat (100), warmup (2), seed (1), nbJoints (6) {}
+  };
+
+  struct Result {
+    std::string name;
+    std::size_t iterations;
+    LatencyHistogram durations;
+    std::string error;
+  };
+
+  hpp::Names_t names (const char* n0, const char* n1 = 0x0)
+  {
+    hpp::Names_t n;
+    n.length (n1 ? 2 : 1);
+    n[0] = n0;
+    if (n1) n[1] = n1;
+    return n;
+  }
+
+  hpp::floatSeq toFloatSeq (const std::vector <double>& v)
+  {
+    hpp::floatSeq s;
+    s.length ((CORBA::ULong) v.size ());
+    for (std::size_t i = 0; i < v.size (); ++i) s[(CORBA::ULong) i] = v[i];
+    return s;
+  }
+
+  /// Servants and state shared by the workloads.
+  class Workloads
+  {
+    public:
+      typedef void (Workloads::*Step) ();
+
+      Workloads (ManipulationServer& server, const Options& opts) :
+        server_ (server), opts_ (opts), rng_ (opts.seed), iteration_ (0)
+      {
+        graph_.setServer (&server);
+        problem_.setServer (&server);
+        robot_.setServer (&server);
+      }
+
+      /// Run setup once, then body warmup + repeat times.
+      Result measure (const std::string& name, Step setup, Step body)
+      {
+        Result r;
+        r.name = name;
+        r.iterations = 0;
+        try {
+          if (setup) (this->*setup) ();
+          for (iteration_ = 0; iteration_ < opts_.warmup + opts_.repeat;
+              ++iteration_) {
+            ServerMetrics::value_type start = ServerMetrics::now ();
+            (this->*body) ();
+            ServerMetrics::value_type end = ServerMetrics::now ();
+            if (iteration_ >= opts_.warmup) {
+              r.durations.record (end - start);
+              ++r.iterations;
+            }
+          }
+        } catch (const hpp::Error& e) {
+          r.error = e.msg.in ();
+        } catch (const std::exception& e) {
+          r.error = e.what ();
+        }
+        return r;
+      }
+
+      /// \name Setup steps
+      /// \{
+
+      void loadScene ()
+      {
+        problem_.resetProblem ();
+        robot_.insertRobotModelFromString ("arm", "anchor",
+            bm::armUrdf (opts_.nbJoints).c_str (),
+            bm::armSrdf (opts_.nbJoints).c_str ());
+        robot_.insertRobotModelFromString ("box", "freeflyer",
+            bm::boxUrdf ().c_str (), bm::boxSrdf ().c_str ());
+        robot_.loadEnvironmentModelFromString (bm::tableUrdf ().c_str (),
+            bm::tableSrdf ().c_str (), "table");
+      }
+
+      void prepareGraph ()
+      {
+        loadScene ();
+        problem_.createGrasp ("grasp", "arm/gripper", "box/handle");
+        problem_.createPlacementConstraint ("placement",
+            names ("box/bottom"), names ("table/top"));
+        generateConfigs ();
+      }
+
+      void prepareAutoBuiltGraph ()
+      {
+        prepareGraph ();
+        autoBuild ();
+      }
+
+      void prepareManualGraph ()
+      {
+        prepareGraph ();
+        buildGraph ();
+      }
+
+      void prepareProjectedConfigs ()
+      {
+        prepareManualGraph ();
+        CORBA::Double error;
+        for (std::size_t i = 0; i < configs_.size (); ++i) {
+          hpp::floatSeq_var out;
+          problem_.applyConstraints (free_, configs_[i], out.out (), error);
+          configs_[i] = out.in ();
+        }
+      }
+
+      void preparePath ()
+      {
+        prepareProjectedConfigs ();
+        CORBA::Long notProj, proj;
+        if (!problem_.buildAndProjectPath (transit_, configs_[0], configs_[1],
+              notProj, proj) || notProj < 0)
+          throw std::runtime_error ("Failed to build the path.");
+        pathId_ = (proj >= 0 ? proj : notProj);
+        double length = problemSolver ()->paths () [pathId_]->length ();
+        boost::uniform_real <double> u (0, length);
+        params_.resize (configs_.size ());
+        for (std::size_t i = 0; i < params_.size (); ++i)
+          params_[i] = u (rng_);
+      }
+
+      /// \}
+
+      /// \name Measured steps
+      /// \{
+
+      void buildGraph ()
+      {
+        graph_.createGraph ("manual");
+        CORBA::Long sg = graph_.createSubGraph ("manual_sg");
+        free_ = graph_.createNode (sg, "free", false, 0);
+        grasp_ = graph_.createNode (sg, "grasp", false, 0);
+        transit_ = graph_.createEdge (free_, free_, "transit", 1, free_);
+        CORBA::Long graspEdge =
+          graph_.createEdge (free_, grasp_, "grasp", 1, free_);
+        CORBA::Long release =
+          graph_.createEdge (grasp_, free_, "release", 1, free_);
+        CORBA::Long transfer =
+          graph_.createEdge (grasp_, grasp_, "transfer", 1, grasp_);
+        hpp::Names_t none;
+        graph_.addNumericalConstraints (free_, names ("placement"), none);
+        graph_.addNumericalConstraints (grasp_, names ("grasp"), none);
+        graph_.addNumericalConstraints (transit_,
+            names ("placement/complement"), none);
+        graph_.addNumericalConstraints (graspEdge,
+            names ("placement/complement"), none);
+        graph_.addNumericalConstraints (release,
+            names ("placement/complement"), none);
+        graph_.addNumericalConstraints (transfer,
+            names ("grasp/complement"), none);
+        graph_.initialize ();
+      }
+
+      void autoBuild ()
+      {
+        hpp::corbaserver::manipulation::Namess_t handles, contacts;
+        handles.length (1);
+        handles[0] = names ("box/handle");
+        contacts.length (1);
+        contacts[0] = names ("box/bottom");
+        hpp::corbaserver::manipulation::Rules rules;
+        rules.length (1);
+        rules[0].grippers = names (".*");
+        rules[0].handles = names (".*");
+        rules[0].link = true;
+        hpp::intSeq_var ids = graph_.autoBuild ("auto", names ("arm/gripper"),
+            names ("box"), handles, contacts, names ("table/top"), rules);
+        graph_.initialize ();
+      }
+
+      void getGraph ()
+      {
+        hpp::GraphComp_var comp;
+        hpp::GraphElements_var elmts;
+        graph_.getGraph (comp.out (), elmts.out ());
+      }
+
+      void applyConstraints ()
+      {
+        hpp::floatSeq_var out;
+        CORBA::Double error;
+        problem_.applyConstraints (grasp_, config (), out.out (), error);
+      }
+
+      void buildAndProjectPath ()
+      {
+        CORBA::Long notProj, proj;
+        const std::size_t i = iteration_ % configs_.size ();
+        problem_.buildAndProjectPath (transit_, configs_[i],
+            configs_[(i + 1) % configs_.size ()], notProj, proj);
+      }
+
+      void edgeAtParam ()
+      {
+        problem_.edgeAtParam ((CORBA::ULong) pathId_,
+            params_[iteration_ % params_.size ()]);
+      }
+
+      /// \}
+
+      std::size_t configSize ()
+      {
+        return problemSolver ()->robot ()->configSize ();
+      }
+
+    private:
+      hpp::core::ProblemSolverPtr_t problemSolver ()
+      {
+        return server_.problemSolverMap ()->selected ();
+      }
+
+      const hpp::floatSeq& config () const
+      {
+        return configs_[iteration_ % configs_.size ()];
+      }
+
+      /// Arm joints uniformly in [-1, 1], box on the table.
+      void generateConfigs ()
+      {
+        boost::uniform_real <double> u (-1, 1);
+        const std::size_t nq = configSize ();
+        configs_.resize (std::max <std::size_t> (opts_.repeat, 2));
+        for (std::size_t i = 0; i < configs_.size (); ++i) {
+          std::vector <double> q (nq, 0);
+          for (std::size_t j = 0; j < opts_.nbJoints; ++j) q[j] = u (rng_);
+          // Box freeflyer: x y z qx qy qz qw
+          q[nq - 7] = 0.6 + 0.2 * u (rng_);
+          q[nq - 6] = 0.4 * u (rng_);
+          q[nq - 5] = 0.55;
+          q[nq - 1] = 1;
+          configs_[i] = toFloatSeq (q);
+        }
+      }
+
+      ManipulationServer& server_;
+      const Options& opts_;
+      boost::mt19937 rng_;
+      hpp::manipulation::impl::Graph graph_;
+      hpp::manipulation::impl::Problem problem_;
+      hpp::manipulation::impl::Robot robot_;
+
+      std::size_t iteration_;
+      std::vector <hpp::floatSeq> configs_;
+      std::vector <double> params_;
+      CORBA::Long free_, grasp_, transit_, pathId_;
+  };
+
+  /// Escape a string to be written between quotes in JSON. Control
+  /// characters are replaced by spaces.
+  std::string escape (const std::string& s)
+  {
+    std::string e;
+    for (std::size_t i = 0; i < s.size (); ++i) {
+      if (s[i] == '"' || s[i] == '\\') e += '\\';
+      if ((unsigned char) s[i] < 0x20) e += ' ';
+      else e += s[i];
+    }
+    return e;
+  }
+
+  void writeJson (std::ostream& os, const Options& opts,
+      std::size_t configSize, const std::vector <Result>& results)
+  {
+    os << "{\n"
+      << "  \"benchmark\": \"hpp-manipulation-benchmark\",\n"
+      << "  \"label\": \"" << escape (opts.label) << "\",\n"
+      << "  \"seed\": " << opts.seed << ",\n"
+      << "  \"repeat\": " << opts.repeat << ",\n"
+      << "  \"warmup\": " << opts.warmup << ",\n"
+      << "  \"nbJoints\": " << opts.nbJoints << ",\n"
+      << "  \"configSize\": " << configSize << ",\n"
+      << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size (); ++i) {
+      const Result& r = results[i];
+      const LatencyHistogram& h = r.durations;
+      os << (i == 0 ? "\n" : ",\n")
+        << "    {\"name\": \"" << r.name << "\""
+        << ", \"iterations\": " << r.iterations
+        << ", \"mean_us\": " << h.mean () * 1e-3
+        << ", \"p50_us\": " << (double) h.quantile (.5) * 1e-3
+        << ", \"p90_us\": " << (double) h.quantile (.9) * 1e-3
+        << ", \"p99_us\": " << (double) h.quantile (.99) * 1e-3
+        << ", \"max_us\": " << (double) h.max () * 1e-3;
+      if (!r.error.empty ())
+        os << ", \"error\": \"" << escape (r.error) << "\"";
+      os << "}";
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  bool parse (int argc, char* argv [], Options& opts)
+  {
+    for (int i = 1; i < argc; ++i) {
+      const bool hasValue = (i + 1 < argc);
+      if (hasValue && strcmp (argv[i], "--repeat") == 0)
+        opts.repeat = (std::size_t) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--warmup") == 0)
+        opts.warmup = (std::size_t) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--seed") == 0)
+        opts.seed = (unsigned int) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--joints") == 0)
+        opts.nbJoints = (std::size_t) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--filter") == 0)
+        opts.filter = argv[++i];
+      else if (hasValue && strcmp (argv[i], "--label") == 0)
+        opts.label = argv[++i];
+      else if (hasValue && strcmp (argv[i], "--output") == 0)
+        opts.output = argv[++i];
+      else if (strcmp (argv[i], "--help") == 0)
+        return false;
+    }
+    return opts.repeat > 0 && opts.nbJoints > 0;
+  }
+}
+
+int main (int argc, char* argv [])
+{
+  Options opts;
+  if (!parse (argc, argv, opts)) {
+    std::cerr << "Usage: " << argv[0] << " [--repeat N] [--warmup N]"
+      " [--seed S] [--joints N] [--filter substring] [--label text]"
+      " [--output file.json]" << std::endl;
+    return 1;
+  }
+  // The planners draw random numbers with rand ().
+  srand (opts.seed);
+
+  // The ORB is initialized by the server but requests are never dispatched
+  // through it: the servants below are called directly.
+  ManipulationServer server (argc, const_cast<const char**> (argv), false);
+  hpp::corbaServer::ProblemSolverMapPtr_t psMap
+    (new hpp::corbaServer::ProblemSolverMap (new ProblemSolver ()));
+  server.setProblemSolverMap (psMap);
+
+  Workloads w (server, opts);
+
+  struct Entry {
+    const char* name;
+    Workloads::Step setup, body;
+  } entries [] = {
+    // resetProblem, then insertion of the arm, the box and the table.
+    { "Robot.loadScene", 0x0, &Workloads::loadScene },
+    { "Graph.build", &Workloads::prepareGraph, &Workloads::buildGraph },
+    { "Graph.autoBuild", &Workloads::prepareGraph, &Workloads::autoBuild },
+    { "Graph.getGraph", &Workloads::prepareAutoBuiltGraph,
+      &Workloads::getGraph },
+    { "Problem.applyConstraints", &Workloads::prepareManualGraph,
+      &Workloads::applyConstraints },
+    { "Problem.buildAndProjectPath", &Workloads::prepareProjectedConfigs,
+      &Workloads::buildAndProjectPath },
+    { "Problem.edgeAtParam", &Workloads::preparePath,
+      &Workloads::edgeAtParam }
+  };
+
+  std::vector <Result> results;
+  for (std::size_t i = 0; i < sizeof (entries) / sizeof (Entry); ++i) {
+    if (!opts.filter.empty ()
+        && std::string (entries[i].name).find (opts.filter)
+        == std::string::npos)
+      continue;
+    results.push_back (w.measure (entries[i].name, entries[i].setup,
+          entries[i].body));
+  }
+
+  std::size_t configSize = 0;
+  try {
+    w.loadScene ();
+    configSize = w.configSize ();
+  } catch (const hpp::Error&) {}
+
+  if (opts.output.empty ())
+    writeJson (std::cout, opts, configSize, results);
+  else {
+    std::ofstream file (opts.output.c_str ());
+    writeJson (file, opts, configSize, results);
+  }
+  for (std::size_t i = 0; i < results.size (); ++i)
+    if (!results[i].error.empty ()) return 2;
+  return 0;
+}
@@ -15,6 +15,14 @@
 // hpp-manipulation-corba.  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <hpp/corbaserver/server.hh>
 #include <hpp/manipulation/package-config.hh>
 #if HPP_MANIPULATION_HAS_WHOLEBODY_STEP
@@ -23,6 +31,10 @@
 #include <hpp/corbaserver/manipulation/server.hh>
 #include <hpp/manipulation/problem-solver.hh>
 
+#include "metrics.hh"
+#include "model-cache.hh"
+#include "scheduler.hh"
+
 typedef hpp::corbaServer::Server CorbaServer;
 #if HPP_MANIPULATION_HAS_WHOLEBODY_STEP
   typedef hpp::wholebodyStep::Server WholebodyServer;
@@ -33,24 +45,151 @@ typedef hpp::manipulation::ProblemSolverPtr_t ProblemSolverPtr_t;
 typedef hpp::manipulation::ManipulationPlanner ManipulationPlanner;
 typedef hpp::manipulation::ManipulationPlannerPtr_t ManipulationPlannerPtr_t;
 
+namespace {
+  void usage (const char* program)
+  {
+    std::cerr << "Usage: " << program << " [options] [ORB options]\n"
+      "  --singlethread         process one request at a time.\n"
+      "  --threads N            size of the ORB worker pool.\n"
+      "  --queue NAME:SLOTS:BOUND\n"
+      "                         create or modify a priority class that runs\n"
+      "                         SLOTS requests (0 for no limit) and queues\n"
+      "                         BOUND requests. Default: heavy:2:32. With\n"
+      "                         --threads N, the running and queued requests\n"
+      "                         of the limited classes must leave one thread\n"
+      "                         of the pool, and heavy defaults to at most\n"
+      "                         N-1 of them.\n"
+      "  --route OPERATION=NAME route an operation (\"Problem.getAvailable\"\n"
+      "                         or \"getAvailable\") to a priority class.\n"
+      "  --model-cache DIR      store parsed environment models in DIR.\n"
+      "                         Default: $HPP_MANIPULATION_MODEL_CACHE.\n";
+  }
+
+  struct QueueOption {
+    std::string name;
+    std::size_t slots, bound;
+  };
+
+  bool parseQueue (const char* arg, QueueOption& q)
+  {
+    std::string s (arg);
+    std::string::size_type i = s.find (':'), j = s.rfind (':');
+    if (i == std::string::npos || i == 0 || j <= i + 1) return false;
+    char* end;
+    q.name = s.substr (0, i);
+    q.slots = std::strtoul (s.c_str () + i + 1, &end, 10);
+    if (end != s.c_str () + j) return false;
+    q.bound = std::strtoul (s.c_str () + j + 1, &end, 10);
+    return *end == '\0';
+  }
+}
+
 int main (int argc, char* argv [])
 {
   bool multithread = true;
-  for (int i = 0; i < argc; ++i)
+  std::string threads;
+  std::vector <QueueOption> queues;
+  std::vector <std::pair <std::string, std::string> > routes;
+  const char* modelCache = NULL;
+  for (int i = 0; i < argc; ++i) {
     if (strcmp(argv[i], "--singlethread") == 0)
       multithread = false;
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      threads = argv[++i];
+      if (std::atoi (threads.c_str ()) <= 0) {
+        usage (argv[0]);
+        return 1;
+      }
+    } else if (strcmp(argv[i], "--queue") == 0 && i + 1 < argc) {
+      QueueOption q;
+      if (!parseQueue (argv[++i], q)) {
+        usage (argv[0]);
+        return 1;
+      }
+      queues.push_back (q);
+    } else if (strcmp(argv[i], "--route") == 0 && i + 1 < argc) {
+      std::string r (argv[++i]);
+      std::string::size_type eq = r.find ('=');
+      if (eq == std::string::npos || eq == 0 || eq + 1 == r.size ()) {
+        usage (argv[0]);
+        return 1;
+      }
+      routes.push_back (std::make_pair (r.substr (0, eq), r.substr (eq + 1)));
+    } else if (strcmp(argv[i], "--model-cache") == 0 && i + 1 < argc) {
+      modelCache = argv[++i];
+    } else if (strcmp(argv[i], "--help") == 0) {
+      usage (argv[0]);
+      return 0;
+    }
+  }
+
+  // The ORB is initialized by the first server, with these arguments.
+  std::vector <const char*> args (argv, argv + argc);
+  if (!threads.empty ()) {
+    // Serve the requests by a pool of threads rather than by one thread
+    // per connection.
+    args.push_back ("-ORBthreadPerConnectionPolicy");
+    args.push_back ("0");
+    args.push_back ("-ORBmaxServerThreadPoolSize");
+    args.push_back (threads.c_str ());
+  }
+  int nargs = (int) args.size ();
+  args.push_back (NULL);
+
+  // The ORB is initialized by the constructor of corbaServer, so the
+  // interceptors of the metrics must be registered before.
+  hpp::manipulation::impl::ServerMetrics::installInterceptors ();
 
   ProblemSolverPtr_t problemSolver = new ProblemSolver();
 
-  CorbaServer corbaServer (problemSolver, argc,
-			   const_cast<const char**> (argv), multithread);
+  CorbaServer corbaServer (problemSolver, nargs, &args[0], multithread);
   #if HPP_MANIPULATION_HAS_WHOLEBODY_STEP  
-    WholebodyServer wbsServer (argc, const_cast<const char**> (argv), multithread);
+    WholebodyServer wbsServer (nargs, &args[0], multithread);
     wbsServer.setProblemSolverMap (corbaServer.problemSolverMap());
   #endif
-  ManipulationServer manipServer (argc, const_cast<const char**> (argv), multithread);
+  ManipulationServer manipServer (nargs, &args[0], multithread);
   manipServer.setProblemSolverMap (corbaServer.problemSolverMap());
 
+  if (modelCache != NULL)
+    manipServer.modelCache ().directory (modelCache);
+
+  try {
+    if (!threads.empty ()) {
+      const std::size_t n = (std::size_t) std::atoi (threads.c_str ());
+      if (n >= 2) {
+        const std::size_t slots = std::min <std::size_t> (2, n - 1);
+        manipServer.scheduler ().setClass ("heavy", slots,
+            std::min <std::size_t> (32, n - 1 - slots));
+      }
+    }
+    for (std::size_t i = 0; i < queues.size (); ++i)
+      manipServer.scheduler ().setClass
+        (queues[i].name, queues[i].slots, queues[i].bound);
+    for (std::size_t i = 0; i < routes.size (); ++i)
+      manipServer.scheduler ().route (routes[i].first, routes[i].second);
+  } catch (const std::invalid_argument& e) {
+    std::cerr << e.what () << std::endl;
+    return 1;
+  }
+
+  if (!threads.empty ()) {
+    // A queued request holds a thread of the pool while it waits. If the
+    // limited classes could hold all of them, nothing else would be served.
+    // With a single thread, requests never wait in the queues.
+    const std::size_t n = (std::size_t) std::atoi (threads.c_str ());
+    const hpp::manipulation::impl::Scheduler::Queues_t q =
+      manipServer.scheduler ().snapshot (false);
+    std::size_t held = 0;
+    for (std::size_t i = 0; i < q.size (); ++i)
+      if (q[i].slots != 0) held += q[i].slots + q[i].bound;
+    if (n >= 2 && held > n - 1) {
+      std::cerr << "The priority classes may hold " << held
+        << " threads of the pool of " << n << ": at most " << n - 1
+        << " are allowed, to keep one for the other requests." << std::endl;
+      return 1;
+    }
+  }
+
   corbaServer.startCorbaServer ();
   #if HPP_MANIPULATION_HAS_WHOLEBODY_STEP  
     wbsServer.startCorbaServer (corbaServer.mainContextId(), "corbaserver",
@@ -0,0 +1,464 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+// Load generator measuring the CORBA path to hpp-manipulation-server.
+//
+// Usage: hpp-manipulation-loadgen [--threads N] [--duration seconds]
+//            [--warmup seconds] [--mix op:weight,op:weight,...]
+//            [--joints N] [--seed S] [--server path] [--singlethread]
+//            [--no-spawn] [--output file.json] [ORB options]
+//
+// Unless --no-spawn is given, a server is started (with --singlethread if
+// requested) and stopped at the end. A naming service must be running.
+// The synthetic scene of benchmark-models.hh is loaded in a problem named
+// "hpp-manipulation-loadgen", then N threads call the operations of the mix
+// as fast as possible. The throughput and the latency quantiles of each
+// operation are written in JSON.
+//
+// Available operations: getAvailable, getEnvironmentContactNames, getGraph,
+// getNumericalConstraints, applyConstraints. applyConstraints modifies
+// the constraints of the server: with several threads, only use it against
+// a --singlethread server.
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+
+#include <hpp/corbaserver/manipulation/client.hh>
+
+#include "metrics.hh"
+#include "latency-histogram.hh"
+#include "benchmark-models.hh"
+
+typedef hpp::corbaServer::manipulation::Client Client;
+typedef hpp::manipulation::impl::LatencyHistogram LatencyHistogram;
+typedef hpp::manipulation::impl::ServerMetrics ServerMetrics;
+
+namespace bm = hpp::manipulation::benchmark;
+
+namespace {
+  enum Operation {
+    GET_AVAILABLE,
+    GET_ENVIRONMENT_CONTACT_NAMES,
+    GET_GRAPH,
+    GET_NUMERICAL_CONSTRAINTS,
+    APPLY_CONSTRAINTS,
+    NB_OPERATIONS
+  };
+
+  const char* operationNames [NB_OPERATIONS] = {
+    "getAvailable",
+    "getEnvironmentContactNames",
+    "getGraph",
+    "getNumericalConstraints",
+    "applyConstraints"
+  };
+
+  struct Options {
+    std::size_t nbThreads;
+    double duration;
+    double warmup;
+    std::string mix;
+    std::size_t nbJoints;
+    unsigned int seed;
+    std::string server;
+    bool singleThread;
+    bool spawn;
+    std::string output;
+
+    Options () : nbThreads (4), duration (10), warmup (1),
+    mix ("getAvailable:1,getEnvironmentContactNames:1,getGraph:1,"
+        "getNumericalConstraints:1"),
+    nbJoints (6), seed (1), server ("hpp-manipulation-server"),
+    singleThread (false), spawn (true) {}
+  };
+
+  struct Statistics {
+    LatencyHistogram latencies [NB_OPERATIONS];
+    ServerMetrics::value_type errors [NB_OPERATIONS];
+
+    Statistics ()
+    {
+      std::fill (errors, errors + NB_OPERATIONS, 0);
+    }
+
+    void merge (const Statistics& other)
+    {
+      for (std::size_t i = 0; i < NB_OPERATIONS; ++i) {
+        latencies[i].merge (other.latencies[i]);
+        errors[i] += other.errors[i];
+      }
+    }
+  };
+
+  hpp::Names_t names (const char* n0)
+  {
+    hpp::Names_t n;
+    n.length (1);
+    n[0] = n0;
+    return n;
+  }
+
+  /// Cumulative weights of the operations.
+  std::vector <double> parseMix (const std::string& mix)
+  {
+    std::vector <double> cumulative (NB_OPERATIONS, 0);
+    std::vector <double> weights (NB_OPERATIONS, 0);
+    std::istringstream is (mix);
+    std::string item;
+    while (std::getline (is, item, ',')) {
+      std::string::size_type colon = item.find (':');
+      std::string name = item.substr (0, colon);
+      double w = (colon == std::string::npos ? 1
+          : atof (item.substr (colon + 1).c_str ()));
+      std::size_t i = 0;
+      while (i < NB_OPERATIONS && name != operationNames[i]) ++i;
+      if (i == NB_OPERATIONS)
+        throw std::invalid_argument ("Unknown operation " + name);
+      weights[i] += w;
+    }
+    double total = 0;
+    for (std::size_t i = 0; i < NB_OPERATIONS; ++i) {
+      total += weights[i];
+      cumulative[i] = total;
+    }
+    if (total <= 0) throw std::invalid_argument ("Empty operation mix");
+    return cumulative;
+  }
+
+  /// Scene and graph element ids shared by the client threads.
+  struct Scene {
+    hpp::ID freeState;
+    std::vector <hpp::floatSeq> configs;
+  };
+
+  void loadScene (Client& client, const Options& opts, Scene& scene)
+  {
+    client.problem ()->selectProblem ("hpp-manipulation-loadgen");
+    client.problem ()->resetProblem ();
+    client.robot ()->insertRobotModelFromString ("arm", "anchor",
+        bm::armUrdf (opts.nbJoints).c_str (),
+        bm::armSrdf (opts.nbJoints).c_str ());
+    client.robot ()->insertRobotModelFromString ("box", "freeflyer",
+        bm::boxUrdf ().c_str (), bm::boxSrdf ().c_str ());
+    client.robot ()->loadEnvironmentModelFromString
+      (bm::tableUrdf ().c_str (), bm::tableSrdf ().c_str (), "table");
+
+    hpp::corbaserver::manipulation::Namess_t handles, contacts;
+    handles.length (1);
+    handles[0] = names ("box/handle");
+    contacts.length (1);
+    contacts[0] = names ("box/bottom");
+    hpp::corbaserver::manipulation::Rules rules;
+    rules.length (1);
+    rules[0].grippers = names (".*");
+    rules[0].handles = names (".*");
+    rules[0].link = true;
+    hpp::intSeq_var ids = client.graph ()->autoBuild ("loadgen",
+        names ("arm/gripper"), names ("box"), handles, contacts,
+        names ("table/top"), rules);
+    client.graph ()->initialize ();
+
+    hpp::GraphComp_var comp;
+    hpp::GraphElements_var elmts;
+    client.graph ()->getGraph (comp.out (), elmts.out ());
+    if (elmts->nodes.length () == 0)
+      throw std::runtime_error ("The graph has no state");
+    scene.freeState = elmts->nodes[0].id;
+    for (CORBA::ULong i = 0; i < elmts->nodes.length (); ++i)
+      if (strcmp (elmts->nodes[i].name.in (), "free") == 0)
+        scene.freeState = elmts->nodes[i].id;
+
+    // Arm joints in [-1, 1], box freeflyer on the table.
+    boost::mt19937 rng (opts.seed);
+    boost::uniform_real <double> u (-1, 1);
+    const CORBA::ULong nq = (CORBA::ULong) opts.nbJoints + 7;
+    scene.configs.resize (64);
+    for (std::size_t i = 0; i < scene.configs.size (); ++i) {
+      hpp::floatSeq& q = scene.configs[i];
+      q.length (nq);
+      for (CORBA::ULong j = 0; j < nq; ++j) q[j] = 0;
+      for (CORBA::ULong j = 0; j < opts.nbJoints; ++j) q[j] = u (rng);
+      q[nq - 7] = 0.6 + 0.2 * u (rng);
+      q[nq - 6] = 0.4 * u (rng);
+      q[nq - 5] = 0.55;
+      q[nq - 1] = 1;
+    }
+  }
+
+  void call (Client& client, const Scene& scene, Operation op,
+      std::size_t i)
+  {
+    switch (op) {
+      case GET_AVAILABLE: {
+        hpp::Names_t_var n = client.problem ()->getAvailable ("handle");
+        break;
+      }
+      case GET_ENVIRONMENT_CONTACT_NAMES: {
+        hpp::Names_t_var n = client.problem ()->getEnvironmentContactNames ();
+        break;
+      }
+      case GET_GRAPH: {
+        hpp::GraphComp_var comp;
+        hpp::GraphElements_var elmts;
+        client.graph ()->getGraph (comp.out (), elmts.out ());
+        break;
+      }
+      case GET_NUMERICAL_CONSTRAINTS: {
+        hpp::Names_t_var n;
+        client.graph ()->getNumericalConstraints (scene.freeState, n.out ());
+        break;
+      }
+      case APPLY_CONSTRAINTS: {
+        hpp::floatSeq_var out;
+        CORBA::Double error;
+        client.problem ()->applyConstraints (scene.freeState,
+            scene.configs[i % scene.configs.size ()], out.out (), error);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  void worker (Client& client, const Scene& scene,
+      const std::vector <double>& mix, unsigned int seed,
+      ServerMetrics::value_type start, ServerMetrics::value_type end,
+      Statistics& stats)
+  {
+    boost::mt19937 rng (seed);
+    boost::uniform_real <double> u (0, mix.back ());
+    for (std::size_t i = 0; ; ++i) {
+      const double r = u (rng);
+      std::size_t op = 0;
+      while (op + 1 < NB_OPERATIONS && r >= mix[op]) ++op;
+
+      const ServerMetrics::value_type t0 = ServerMetrics::now ();
+      if (t0 >= end) break;
+      bool failed = false;
+      try {
+        call (client, scene, (Operation) op, i);
+      } catch (const CORBA::Exception&) {
+        failed = true;
+      }
+      const ServerMetrics::value_type t1 = ServerMetrics::now ();
+      if (t0 < start) continue;
+      if (failed) ++stats.errors[op];
+      else stats.latencies[op].record (t1 - t0);
+    }
+  }
+
+  pid_t spawnServer (const Options& opts)
+  {
+    pid_t pid = fork ();
+    if (pid < 0) throw std::runtime_error ("fork failed");
+    if (pid == 0) {
+      std::vector <char*> args;
+      args.push_back (const_cast <char*> (opts.server.c_str ()));
+      if (opts.singleThread)
+        args.push_back (const_cast <char*> ("--singlethread"));
+      args.push_back (0x0);
+      execvp (args[0], &args[0]);
+      std::cerr << "Failed to start " << opts.server << std::endl;
+      _exit (127);
+    }
+    return pid;
+  }
+
+  /// Connect, retrying until the server answers.
+  void connect (Client& client, double timeout)
+  {
+    const ServerMetrics::value_type end =
+      ServerMetrics::now () + (ServerMetrics::value_type) (timeout * 1e9);
+    while (true) {
+      try {
+        client.connect ();
+        hpp::Names_t_var types = client.problem ()->getAvailable ("type");
+        return;
+      } catch (const CORBA::Exception&) {
+        if (ServerMetrics::now () > end)
+          throw std::runtime_error ("Could not connect to the server");
+        usleep (100000);
+      }
+    }
+  }
+
+  void writeLatency (std::ostream& os, const LatencyHistogram& h)
+  {
+    os << "\"p50_us\": " << (double) h.quantile (.5) * 1e-3
+      << ", \"p99_us\": " << (double) h.quantile (.99) * 1e-3
+      << ", \"p999_us\": " << (double) h.quantile (.999) * 1e-3
+      << ", \"max_us\": " << (double) h.max () * 1e-3;
+  }
+
+  void writeJson (std::ostream& os, const Options& opts,
+      const Statistics& stats)
+  {
+    LatencyHistogram all;
+    ServerMetrics::value_type errors = 0;
+    for (std::size_t i = 0; i < NB_OPERATIONS; ++i) {
+      all.merge (stats.latencies[i]);
+      errors += stats.errors[i];
+    }
+    os << "{\n"
+      << "  \"tool\": \"hpp-manipulation-loadgen\",\n"
+      << "  \"server\": \"" << (opts.singleThread ? "singlethread"
+          : "multithread") << "\",\n"
+      << "  \"threads\": " << opts.nbThreads << ",\n"
+      << "  \"duration\": " << opts.duration << ",\n"
+      << "  \"mix\": \"" << opts.mix << "\",\n"
+      << "  \"calls\": " << all.count () << ",\n"
+      << "  \"errors\": " << errors << ",\n"
+      << "  \"throughput\": " << (double) all.count () / opts.duration
+      << ",\n  ";
+    writeLatency (os, all);
+    os << ",\n  \"operations\": [";
+    bool first = true;
+    for (std::size_t i = 0; i < NB_OPERATIONS; ++i) {
+      const LatencyHistogram& h = stats.latencies[i];
+      if (h.count () == 0 && stats.errors[i] == 0) continue;
+      os << (first ? "\n" : ",\n")
+        << "    {\"name\": \"" << operationNames[i] << "\""
+        << ", \"calls\": " << h.count ()
+        << ", \"errors\": " << stats.errors[i]
+        << ", \"throughput\": " << (double) h.count () / opts.duration
+        << ", ";
+      writeLatency (os, h);
+      os << "}";
+      first = false;
+    }
+    os << "\n  ]\n}\n";
+  }
+
+  bool parse (int argc, char* argv [], Options& opts)
+  {
+    for (int i = 1; i < argc; ++i) {
+      const bool hasValue = (i + 1 < argc);
+      if (hasValue && strcmp (argv[i], "--threads") == 0)
+        opts.nbThreads = (std::size_t) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--duration") == 0)
+        opts.duration = atof (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--warmup") == 0)
+        opts.warmup = atof (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--mix") == 0)
+        opts.mix = argv[++i];
+      else if (hasValue && strcmp (argv[i], "--joints") == 0)
+        opts.nbJoints = (std::size_t) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--seed") == 0)
+        opts.seed = (unsigned int) atol (argv[++i]);
+      else if (hasValue && strcmp (argv[i], "--server") == 0)
+        opts.server = argv[++i];
+      else if (hasValue && strcmp (argv[i], "--output") == 0)
+        opts.output = argv[++i];
+      else if (strcmp (argv[i], "--singlethread") == 0)
+        opts.singleThread = true;
+      else if (strcmp (argv[i], "--no-spawn") == 0)
+        opts.spawn = false;
+      else if (strcmp (argv[i], "--help") == 0)
+        return false;
+    }
+    return opts.nbThreads > 0 && opts.duration > 0 && opts.nbJoints > 0;
+  }
+}
+
+int main (int argc, char* argv [])
+{
+  Options opts;
+  if (!parse (argc, argv, opts)) {
+    std::cerr << "Usage: " << argv[0] << " [--threads N]"
+      " [--duration seconds] [--warmup seconds] [--mix op:weight,...]"
+      " [--joints N] [--seed S] [--server path] [--singlethread]"
+      " [--no-spawn] [--output file.json]" << std::endl;
+    return 1;
+  }
+
+  pid_t server = 0;
+  int status = 0;
+  try {
+    std::vector <double> mix = parseMix (opts.mix);
+    if (opts.spawn) server = spawnServer (opts);
+
+    // Object references are shared by the threads. omniORB opens at most
+    // maxGIOPConnectionPerServer connections to the server, 5 by default,
+    // and concurrent calls beyond it wait for a connection on the client.
+    std::ostringstream connections;
+    connections << opts.nbThreads;
+    const std::string maxConnections = connections.str ();
+    std::vector <char*> orbArgs (argv, argv + argc);
+    orbArgs.push_back (const_cast <char*> ("-ORBmaxGIOPConnectionPerServer"));
+    orbArgs.push_back (const_cast <char*> (maxConnections.c_str ()));
+    int orbArgc = (int) orbArgs.size ();
+    orbArgs.push_back (0x0);
+
+    Client client (orbArgc, &orbArgs[0]);
+    connect (client, 30);
+    Scene scene;
+    loadScene (client, opts, scene);
+
+    const ServerMetrics::value_type start = ServerMetrics::now ()
+      + (ServerMetrics::value_type) (opts.warmup * 1e9);
+    const ServerMetrics::value_type end =
+      start + (ServerMetrics::value_type) (opts.duration * 1e9);
+    std::vector <Statistics> stats (opts.nbThreads);
+    boost::thread_group threads;
+    for (std::size_t i = 0; i < opts.nbThreads; ++i)
+      threads.create_thread (boost::bind (&worker, boost::ref (client),
+            boost::cref (scene), boost::cref (mix),
+            opts.seed + (unsigned int) i, start, end,
+            boost::ref (stats[i])));
+    threads.join_all ();
+
+    Statistics total;
+    for (std::size_t i = 0; i < stats.size (); ++i) total.merge (stats[i]);
+    if (opts.output.empty ())
+      writeJson (std::cout, opts, total);
+    else {
+      std::ofstream file (opts.output.c_str ());
+      writeJson (file, opts, total);
+    }
+  } catch (const hpp::Error& e) {
+    std::cerr << e.msg.in () << std::endl;
+    status = 2;
+  } catch (const CORBA::Exception& e) {
+    std::cerr << "CORBA exception: " << e._name () << std::endl;
+    status = 2;
+  } catch (const std::exception& e) {
+    std::cerr << e.what () << std::endl;
+    status = 2;
+  }
+
+  if (server > 0) {
+    kill (server, SIGTERM);
+    waitpid (server, 0x0, 0);
+  }
+  return status;
+}
@@ -17,6 +17,10 @@
 # hpp-manipulation-corba.  If not, see
 # <http://www.gnu.org/licenses/>.
 
+import array
+import mmap
+import struct
+
 from omniORB import CORBA
 import CosNaming
 
@@ -111,3 +115,159 @@ class Client:
         raise CorbaError (
             'failed to narrow client for service manipulation')
     self.robot = client
+
+class CachingProxy:
+  """
+  Cache of the results of queries whose results seldom change.
+
+  The methods have the signature of the corresponding operations of the
+  manipulation servants. A result is kept until the version stamp of the
+  part of the problem it depends on changes (see Problem.getVersions).
+
+  Results are shared between calls: do not modify them.
+
+  Modifications made through the servants of hpp-corbaserver are not tracked
+  by the server: call invalidate after them.
+  """
+  def __init__ (self, client, checkEachQuery = True):
+    """
+    :param client: a Client instance.
+    :param checkEachQuery: if False, the version stamps are read only by
+                           refresh and results may be stale in between.
+    """
+    self.client = client
+    self.checkEachQuery = checkEachQuery
+    self.hits = 0
+    self.misses = 0
+    self.invalidate ()
+
+  def invalidate (self):
+    """ Drop all the results. """
+    self.versions = None
+    self._graph = {}
+    self._problem = {}
+    self._robot = {}
+    self._problemAndRobot = {}
+
+  def refresh (self):
+    """ Read the version stamps and drop the outdated results. """
+    v = self.client.problem.getVersions ()
+    old = self.versions
+    if old is None or v.graph != old.graph:
+      self._graph = {}
+    if old is None or v.problem != old.problem:
+      self._problem = {}
+      self._problemAndRobot = {}
+    if old is None or v.robot != old.robot:
+      self._robot = {}
+      self._problemAndRobot = {}
+    self.versions = v
+
+  def _get (self, cache, key, query, *args):
+    if self.checkEachQuery or self.versions is None:
+      self.refresh ()
+    cache = getattr (self, cache)
+    if key in cache:
+      self.hits += 1
+    else:
+      self.misses += 1
+      cache[key] = query (*args)
+    return cache[key]
+
+  def getGraph (self):
+    return self._get ("_graph", ("getGraph",),
+        self.client.graph.getGraph)
+
+  def getNumericalConstraints (self, graphComponentId):
+    return self._get ("_graph", ("getNumericalConstraints", graphComponentId),
+        self.client.graph.getNumericalConstraints, graphComponentId)
+
+  def getAvailable (self, type):
+    return self._get ("_problemAndRobot", ("getAvailable", type),
+        self.client.problem.getAvailable, type)
+
+  def getEnvironmentContactNames (self):
+    return self._get ("_problem", ("getEnvironmentContactNames",),
+        self.client.problem.getEnvironmentContactNames)
+
+  def getGripperPositionInJoint (self, gripperName):
+    return self._get ("_robot", ("getGripperPositionInJoint", gripperName),
+        self.client.robot.getGripperPositionInJoint, gripperName)
+
+  def getHandlePositionInJoint (self, handleName):
+    return self._get ("_robot", ("getHandlePositionInJoint", handleName),
+        self.client.robot.getHandlePositionInJoint, handleName)
+
+class SharedChannelReader:
+  """
+  Client side of a shared-memory channel, for clients on the same host as
+  the server.
+
+  The layout is described in hpp/corbaserver/manipulation/shared-channel.hh.
+
+  Example:
+    id, name, size = client.problem.openSharedChannel (1 << 24)
+    reader = SharedChannelReader (name)
+    client.problem.sendPathSamples (id, 0, 0.01)
+    kind, sequence, rows = reader.read ()
+  """
+  _channelHeader = struct.Struct ("=IIQQQ32x")
+  _recordHeader = struct.Struct ("=IIQQQ")
+  magic = 0x43505048
+  version = 1
+
+  PADDING = 0
+  CONFIGURATIONS = 1
+  PATH_SAMPLES = 2
+
+  def __init__ (self, name):
+    """
+    :param name: name returned by Problem.openSharedChannel.
+    """
+    f = open ("/dev/shm/" + name, "r+b")
+    try:
+      self.map = mmap.mmap (f.fileno (), 0)
+    finally:
+      f.close ()
+    magic, version, self.capacity, head, tail = \
+        self._channelHeader.unpack_from (self.map, 0)
+    if magic != self.magic or version != self.version:
+      raise CorbaError (name + ' is not a compatible channel')
+    self.data = self._channelHeader.size
+
+  def _counters (self):
+    return struct.unpack_from ("=QQ", self.map, 16)
+
+  def available (self):
+    """ Number of bytes written and not read yet. """
+    head, tail = self._counters ()
+    return head - tail
+
+  def read (self):
+    """
+    Read the next record, if any.
+    :return: None if the channel is empty, a tuple (kind, sequence, rows)
+             otherwise, where rows is a list of lists of floats.
+    """
+    head, tail = self._counters ()
+    result = None
+    while tail != head and result is None:
+      pos = tail % self.capacity
+      if self.capacity - pos < self._recordHeader.size:
+        tail += self.capacity - pos
+        continue
+      kind, cols, sequence, nrows, size = \
+          self._recordHeader.unpack_from (self.map, self.data + pos)
+      tail += self._recordHeader.size + size
+      if kind == self.PADDING:
+        continue
+      begin = self.data + pos + self._recordHeader.size
+      values = array.array ('d')
+      values.fromstring (self.map [begin:begin + size])
+      result = (kind, sequence,
+          [ values [i * cols:(i + 1) * cols].tolist () for i in xrange (nrows) ])
+    struct.pack_into ("=Q", self.map, 24, tail)
+    return result
+
+  def close (self):
+    self.map.close ()
@@ -637,6 +637,56 @@ class ConstraintGraph (object):
     ##
     # \}
 
+    ##
+    # \name Roadmap nodes by state
+    # \{
+
+    ## Get the k nearest roadmap nodes of a state.
+    # \param state name of the state, None for any state,
+    # \param connectedComponent rank of the connected component, -1 for any.
+    # \return the ranks of the nodes in the roadmap, their configurations
+    #         and their distances to config.
+    # \sa hpp::corbaserver::manipulation::Graph::getNearestNodesInState
+    def getNearestNodesInState (self, state, config, k = 1,
+                                connectedComponent = -1):
+        return self.client.graph.getNearestNodesInState \
+                (self._stateId (state), connectedComponent, config, k)
+
+    ## Get the roadmap nodes of a state closer than radius.
+    # \sa getNearestNodesInState
+    def getNodesInStateWithinRadius (self, state, config, radius,
+                                     connectedComponent = -1):
+        return self.client.graph.getNodesInStateWithinRadius \
+                (self._stateId (state), connectedComponent, config, radius)
+
+    def _stateId (self, state):
+        if state is None: return -1
+        return self.nodes [state]
+
+    ##
+    # \}
+
+    ## Find the states and edges that cannot be part of a solution.
+    # \param initStates, goalStates lists of state names. If empty, the
+    #        states of the initial and goal configurations of the problem.
+    # \param probes number of random configurations per state and per edge,
+    #        0 to only check reachability,
+    # \param disable whether to set the weight of the pruned edges to 0.
+    # \return a dictionary with the names of the deadStates, emptyEdges and
+    #         prunedEdges, or their ids for the waypoints.
+    # \sa hpp::corbaserver::manipulation::Graph::analyze
+    def analyze (self, initStates = [], goalStates = [], probes = 20,
+                 disable = False):
+        pruned, dead, empty = self.client.graph.analyze \
+                ([ self.nodes [s] for s in initStates ],
+                 [ self.nodes [s] for s in goalStates ], probes, disable)
+        stateNames = dict ((id, name) for name, id in self.nodes.items ())
+        edgeNames = dict ((id, name) for name, id in self.edges.items ())
+        # Waypoint states and edges are not known by name: ids are kept.
+        return { 'deadStates' : [ stateNames.get (i, i) for i in dead ],
+                 'emptyEdges' : [ edgeNames.get (i, i) for i in empty ],
+                 'prunedEdges' : [ edgeNames.get (i, i) for i in pruned ] }
+
     ##
     # \name Automatic building
     # \{
@@ -655,6 +705,68 @@ class ConstraintGraph (object):
     def initialize (self):
         self.graph.initialize()
 
+    ## Set the number of threads used by initialize, 0 for the number of
+    #  cores.
+    def setInitializeThreads (self, threads):
+        self.graph.setInitializeThreads (threads)
+
+    ## Get the time spent initializing each state and edge
+    # \return a dictionary from the component names, or ids for the
+    #         waypoints, to the time in seconds.
+    def getInitializeTimes (self):
+        ids, seconds = self.graph.getInitializeTimes ()
+        names = dict ((id, name) for name, id in self.nodes.items ())
+        names.update ((id, name) for name, id in self.edges.items ())
+        return dict ((names.get (i, i), t) for i, t in zip (ids, seconds))
+
+    ## Initialize the states and edges on demand, from the next call to
+    #  initialize.
+    # \param capacity maximal number of states and edges initialized on
+    #        demand, 0 for no limit.
+    # \sa hpp::corbaserver::manipulation::Graph::setLazyInitialization
+    def setLazyInitialization (self, lazy, capacity = 0):
+        self.graph.setLazyInitialization (lazy, capacity)
+
+    ## Initialize the states and edges not initialized yet, if the
+    #  initialization is lazy.
+    # \sa hpp::corbaserver::manipulation::Graph::completeInitialization
+    def completeInitialization (self):
+        self.graph.completeInitialization ()
+
+    ## Get the statistics of the lazy initialization
+    # \return a dictionary with the numbers of states and edges initialized
+    #         on demand ("materialized"), evicted because of the capacity
+    #         ("evicted") and currently initialized ("resident").
+    def getLazyInitializationStats (self):
+        resident, materialized, evicted = \
+                self.graph.getLazyInitializationStats ()
+        return { "materialized": materialized, "evicted": evicted,
+                "resident": resident }
+
+    ##
+    # \}
+
+    ##
+    # \name Grasp feasibility
+    # \{
+
+    ## Estimate the reachability of grasps by sampling.
+    #  The grasps that never succeed are forbidden in the graphs built
+    #  afterwards by buildGenericGraph.
+    # \param grippers, handles lists of names, all of the robot if empty.
+    # \return a list of hpp.corbaserver.manipulation.GraspFeasibility
+    # \sa hpp::corbaserver::manipulation::Graph::computeGraspFeasibility
+    @staticmethod
+    def computeGraspFeasibility (robot, grippers = [], handles = [],
+                                 trials = 100, maxWitnesses = 3):
+        return robot.client.manipulation.graph.computeGraspFeasibility \
+                (grippers, handles, trials, maxWitnesses)
+
+    ## Add the witnesses of the grasp feasibility table to the roadmap.
+    # \return the number of nodes added.
+    def seedRoadmapWithGraspWitnesses (self):
+        return self.client.graph.seedRoadmapWithGraspWitnesses ()
+
     ##
     # \}
 
@@ -437,6 +437,49 @@ class ProblemSolver (object):
     def generateValidConfig (self, maxIter):
         return self.client.basic.problem.generateValidConfig (maxIter)
 
+    ## Check the collisions of configurations, in parallel
+    #  \param configs list of configurations,
+    #  \return for each configuration, whether it is collision free and the
+    #          names of the first colliding pair found.
+    #  \sa hpp::corbaserver::manipulation::Problem::validateConfigurations
+    def validateConfigurations (self, configs):
+        valid, object1, object2 = \
+            self.client.manipulation.problem.validateConfigurations (configs)
+        return [ (v == 1, o1, o2)
+                 for v, o1, o2 in zip (valid, object1, object2) ]
+
+    ## \name Projection sessions
+    #  \{
+
+    ## Open a session projecting configurations on a state or an edge
+    #  \sa hpp::corbaserver::manipulation::Problem::openProjectionSession
+    def openProjectionSession (self, idComp):
+        return self.client.manipulation.problem.openProjectionSession (idComp)
+
+    ## Project a configuration, starting from the previous solution
+    #  \return whether the projection succeeded, the projected
+    #          configuration, the residual error and the number of
+    #          iterations.
+    def projectInSession (self, session, q):
+        return self.client.manipulation.problem.projectInSession (session, q)
+
+    def closeProjectionSession (self, session):
+        return self.client.manipulation.problem.closeProjectionSession \
+            (session)
+    ## \}
+
+    ## Generate valid configurations in a state of the graph
+    #
+    #  \param stateId ID of the state,
+    #  \param n number of configurations,
+    #  \param timeBudget in seconds,
+    #  \return the configurations and the number of random configurations
+    #          drawn for each of them.
+    #  \sa hpp::corbaserver::manipulation::Problem::generateValidConfigsInState
+    def generateValidConfigsInState (self, stateId, n, timeBudget):
+        return self.client.manipulation.problem.generateValidConfigsInState \
+            (stateId, n, timeBudget)
+
     ## Create a LockedJoint constraint with given value
     #  \param lockedJointName key of the constraint in the ProblemSolver map,
     #  \param jointName name of the joint,
@@ -581,6 +624,7 @@ class ProblemSolver (object):
         return self.client.basic.problem.selectSteeringMethod (steeringMethodType)
 
     def prepareSolveStepByStep (self):
+        self.client.manipulation.graph.completeInitialization ()
         return self.client.basic.problem.prepareSolveStepByStep ()
 
     def executeOneStep (self):
@@ -591,6 +635,7 @@ class ProblemSolver (object):
 
     ## Solve the problem of corresponding ChppPlanner object
     def solve (self):
+        self.client.manipulation.graph.completeInitialization ()
         return self.client.basic.problem.solve ()
 
     ## Make direct connection between two configurations
@@ -633,6 +678,20 @@ class ProblemSolver (object):
     def configAtParam(self, inPathId, atDistance):
         return self.client.basic.problem.configAtParam(inPathId, atDistance)
 
+    ## Sample a path in one request
+    # \param inPathId rank of the path in the problem
+    # \param step if positive, sample with this step from the beginning of
+    #        the path, and at its end.
+    # \param params parameters of the samples, used if step is not positive.
+    # \param withVelocities whether to compute the velocities.
+    # \return a tuple (params, configs, velocities, edgeIds), where edgeIds
+    #         are the ids of the edges that generated the motion at each
+    #         sample, -1 if unknown.
+    def samplePath (self, inPathId, step = 0., params = [],
+            withVelocities = False):
+        return self.client.manipulation.problem.samplePath (inPathId, step,
+                params, withVelocities)
+
     ## Get way points of a path
     #  \param pathId rank of the path in the problem
     def getWaypoints (self, pathId):
@@ -660,6 +719,130 @@ class ProblemSolver (object):
         return self.client.basic.problem.interruptPathPlanning ()
     # \}
 
+    ## \name Asynchronous planning
+    #  \{
+
+    ## Start solving the current problem in a server-side worker thread.
+    #  \return the id of the planning job.
+    #  \note A single job may run on a problem at a time.
+    def startSolve (self):
+        return self.client.manipulation.problem.startSolve ()
+
+    ## Get the progress of a planning job
+    #  \return a structure with fields state, iterations, nbNodes, nbEdges,
+    #          nbConnectedComponents, elapsed, pathId and error.
+    def getSolveStatus (self, jobId):
+        return self.client.manipulation.problem.getSolveStatus (jobId)
+
+    ## Get the statistics of the edges of the graph for a planning job
+    #  \return edgeIds, reasons, freqs where freqs[i][j] is the number of
+    #          failures of edge edgeIds[i] for reason reasons[j].
+    def getSolveEdgeStats (self, jobId):
+        return self.client.manipulation.problem.getSolveEdgeStats (jobId)
+
+    ## Cancel a planning job
+    #  \param deadline time in seconds to wait for the job to stop. If
+    #         negative, wait until it stops.
+    #  \return whether the job is stopped.
+    def cancelSolve (self, jobId, deadline = 0):
+        return self.client.manipulation.problem.cancelSolve (jobId, deadline)
+
+    ## Wait for a planning job to stop
+    #  \param timeout time in seconds. If negative, wait until it stops.
+    #  \return whether the job is stopped and its status.
+    def waitSolve (self, jobId, timeout = -1):
+        return self.client.manipulation.problem.waitSolve (jobId, timeout)
+    ## \}
+
+    ## \name Server metrics
+    #  \{
+
+    ## Get the statistics of the operations of the manipulation servants
+    #  \param reset whether to reset the statistics afterwards.
+    #  \return a list of structures with fields name, calls, errors and,
+    #          for the unmarshal, compute, marshal and total phases, the
+    #          mean, p50, p90, p99, p999 and max latencies in microseconds.
+    def getServerMetrics (self, reset = False):
+        return self.client.manipulation.problem.getServerMetrics (reset)
+
+    ## Reset the statistics of the operations of the manipulation servants
+    def resetServerMetrics (self):
+        return self.client.manipulation.problem.resetServerMetrics ()
+
+    ## Get the state and statistics of the priority classes of requests
+    #  \param reset whether to reset the statistics afterwards.
+    #  \return a list of structures with fields name, slots, bound, running,
+    #          depth, maxDepth, admitted, rejected and wait, the latency
+    #          summary of the time spent in the queue in microseconds.
+    def getQueueMetrics (self, reset = False):
+        return self.client.manipulation.problem.getQueueMetrics (reset)
+
+    ## Keep the results of the projections on the states and edges
+    #  \param capacity number of results per state or edge, 0 to disable,
+    #  \param quantum inputs are rounded to a multiple of quantum.
+    #  \sa hpp::corbaserver::manipulation::Problem::setProjectionCache
+    def setProjectionCache (self, capacity, quantum = 1e-6):
+        return self.client.manipulation.problem.setProjectionCache \
+            (capacity, quantum)
+
+    ## Get the hits and misses of the projection cache
+    #  \param reset whether to reset the counters afterwards.
+    def getProjectionCacheStats (self, reset = False):
+        return self.client.manipulation.problem.getProjectionCacheStats (reset)
+    ## \}
+
+    ## \name Shared-memory channel
+    #  For clients on the same host, bulk data is written in shared memory.
+    #  \sa hpp.corbaserver.manipulation.client.SharedChannelReader
+    #  \{
+
+    ## Create a shared-memory channel
+    #  \param capacity size of the ring buffer in bytes.
+    #  \return a tuple (id, name, size) where name is the name of the
+    #          shared-memory object.
+    def openSharedChannel (self, capacity):
+        return self.client.manipulation.problem.openSharedChannel (capacity)
+
+    ## Remove a shared-memory channel
+    def closeSharedChannel (self, channel):
+        return self.client.manipulation.problem.closeSharedChannel (channel)
+
+    ## Write the configurations of the roadmap nodes in a channel
+    #  \return the sequence number of the record.
+    def sendRoadmapNodes (self, channel):
+        return self.client.manipulation.problem.sendRoadmapNodes (channel)
+
+    ## Write samples of a path in a channel
+    #  Each row is a parameter followed by the configuration.
+    #  \return the sequence number of the record.
+    def sendPathSamples (self, channel, pathId, step):
+        return self.client.manipulation.problem.sendPathSamples \
+            (channel, pathId, step)
+    ## \}
+
+    ## \name Roadmap persistence
+    #  \{
+
+    ## Save the roadmap in a file
+    #  \sa hpp::corbaserver::manipulation::Problem::exportRoadmap
+    def exportRoadmap (self, filename):
+        return self.client.manipulation.problem.exportRoadmap (filename)
+
+    ## Add the nodes and edges saved in a file to the roadmap
+    #  \return the numbers of nodes and of edges added, and the number of
+    #          edges skipped because their path is not valid.
+    #  \sa hpp::corbaserver::manipulation::Problem::importRoadmap
+    def importRoadmap (self, filename):
+        return self.client.manipulation.problem.importRoadmap (filename)
+    ## \}
+
+    ## Get the version stamps of the selected problem
+    #  \return a structure with fields problem, graph and robot. A stamp
+    #          changes when the corresponding part is modified.
+    #  \sa hpp.corbaserver.manipulation.client.CachingProxy
+    def getVersions (self):
+        return self.client.manipulation.problem.getVersions ()
+
     ## \name exploring the roadmap
     #  \{
 
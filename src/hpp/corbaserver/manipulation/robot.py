@@ -180,6 +180,49 @@ class Robot (object):
                     modelName, urdfSuffix, srdfSuffix, envName)
         self.rootJointType[envName] = "Anchor"
 
+    ## Time spent loading the last model.
+    #  \return a list of (name, seconds): one per mesh for an environment
+    #          loaded from the model cache, otherwise one per mesh missing
+    #          from the model cache followed by one for the model.
+    def getLoadTimes (self):
+        names, seconds = self.client.manipulation.robot.getLoadTimes ()
+        return zip (names, seconds)
+
+    ## Merge the meshes of the environments loaded afterwards in the
+    #  selected problem into a single obstacle checked for collision, named
+    #  after the prefix followed by "merged_obstacles". Each mesh keeps its
+    #  name for distance computation and queries, but is not checked for
+    #  collision.
+    def mergeEnvironmentObstacles (self, merge = True):
+        return self.client.manipulation.robot.mergeEnvironmentObstacles (merge)
+
+    ## \name Scene assembly
+    #  Insert several models and reset the problem once.
+    #  \code
+    #  robot.beginSceneAssembly ()
+    #  robot.insertObjectModel (...)
+    #  robot.loadEnvironmentModel (...)
+    #  robot.commitSceneAssembly ()
+    #  \endcode
+    #  \{
+
+    ## Defer the reset of the problem until commitSceneAssembly.
+    def beginSceneAssembly (self):
+        return self.client.manipulation.robot.beginSceneAssembly ()
+
+    ## Reset the problem once for all the insertions since
+    #  beginSceneAssembly.
+    #  \return the number of insertions.
+    def commitSceneAssembly (self):
+        return self.client.manipulation.robot.commitSceneAssembly ()
+
+    ## End the scene assembly, if any, and reset the problem if models were
+    #  inserted.
+    #  \return the number of insertions.
+    def abortSceneAssembly (self):
+        return self.client.manipulation.robot.abortSceneAssembly ()
+    ## \}
+
     ## Rebuild inner variables rankInConfiguration and rankInVelocity
     def rebuildRanks (self):
         self.jointNames = self.client.basic.robot.getJointNames ()
@@ -357,6 +400,42 @@ class Robot (object):
     def getHandlePositionInJoint (self, handleName):
         return self.client.manipulation.robot.getHandlePositionInJoint (handleName)
 
+    ## Add several grippers in one request.
+    #  \param grippers list of (linkName, gripperName, handlePositioninJoint)
+    def addGrippers (self, grippers):
+        return self.client.manipulation.robot.addGrippers (
+                [ g[0] for g in grippers ], [ g[1] for g in grippers ],
+                [ g[2] for g in grippers ])
+
+    ## Add several handles in one request.
+    #  \param handles list of (linkName, handleName, localPosition) or of
+    #         (linkName, handleName, localPosition, mask), where mask is a
+    #         list of 6 booleans, False for the unconstrained degrees of
+    #         freedom.
+    def addHandles (self, handles):
+        masks = [ [ int (m) for m in (h[3] if len (h) > 3 else [True,]*6) ]
+                  for h in handles ]
+        return self.client.manipulation.robot.addHandles (
+                [ h[0] for h in handles ], [ h[1] for h in handles ],
+                [ h[2] for h in handles ], masks)
+
+    ## Positions of all the grippers.
+    #  \param q configuration at which world positions are computed. The
+    #         current configuration if None.
+    #  \return a dictionary from gripper names to
+    #          (jointName, positionInJoint, position in world frame).
+    def getGripperPositions (self, q = None):
+        names, joints, inJoint, world = \
+            self.client.manipulation.robot.getGripperPositions (q or [])
+        return dict (zip (names, zip (joints, inJoint, world)))
+
+    ## Positions of all the handles.
+    #  \sa getGripperPositions
+    def getHandlePositions (self, q = None):
+        names, joints, inJoint, world = \
+            self.client.manipulation.robot.getHandlePositions (q or [])
+        return dict (zip (names, zip (joints, inJoint, world)))
+
     ## \}
 
     ## \name Collision checking and distance computation
@@ -0,0 +1,136 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_LATENCY_HISTOGRAM_HH
+# define HPP_MANIPULATION_CORBA_LATENCY_HISTOGRAM_HH
+
+# include <algorithm>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Log-linear histogram of durations in nanoseconds.
+      ///
+      /// As in HdrHistogram, each power of two is split into 16 linear
+      /// buckets, which bounds the relative error of the quantiles to about
+      /// 6%, whatever the magnitude of the values. Recording is O(1) and
+      /// does not allocate.
+      class LatencyHistogram
+      {
+        public:
+          typedef boost::uint64_t value_type;
+
+          enum {
+            SUB_BUCKET_BITS = 4,
+            SUB_BUCKETS = 1 << SUB_BUCKET_BITS,
+            NB_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+          };
+
+          LatencyHistogram () : counts_ (NB_BUCKETS, 0)
+          {
+            reset ();
+          }
+
+          void record (value_type v)
+          {
+            ++counts_ [index (v)];
+            ++count_;
+            sum_ += v;
+            if (v > max_) max_ = v;
+          }
+
+          void reset ()
+          {
+            std::fill (counts_.begin (), counts_.end (), 0);
+            count_ = 0;
+            sum_ = 0;
+            max_ = 0;
+          }
+
+          void merge (const LatencyHistogram& other)
+          {
+            for (std::size_t i = 0; i < counts_.size (); ++i)
+              counts_[i] += other.counts_[i];
+            count_ += other.count_;
+            sum_ += other.sum_;
+            if (other.max_ > max_) max_ = other.max_;
+          }
+
+          value_type count () const
+          {
+            return count_;
+          }
+
+          value_type max () const
+          {
+            return max_;
+          }
+
+          double mean () const
+          {
+            return (count_ == 0 ? 0 : (double) sum_ / (double) count_);
+          }
+
+          /// Value below which a fraction q of the records fall.
+          /// The upper bound of the matching bucket is returned.
+          value_type quantile (double q) const
+          {
+            if (count_ == 0) return 0;
+            value_type rank = (value_type) (q * (double) count_);
+            if (rank >= count_) rank = count_ - 1;
+            value_type seen = 0;
+            for (std::size_t i = 0; i < counts_.size (); ++i) {
+              seen += counts_[i];
+              if (seen > rank) {
+                value_type upper = upperBound (i);
+                return (upper < max_ ? upper : max_);
+              }
+            }
+            return max_;
+          }
+
+          static std::size_t index (value_type v)
+          {
+            if (v < SUB_BUCKETS) return (std::size_t) v;
+            int msb = 63;
+            while (!(v >> msb)) --msb;
+            const int shift = msb - SUB_BUCKET_BITS;
+            return (std::size_t) (shift + 1) * SUB_BUCKETS
+              + (std::size_t) ((v >> shift) - SUB_BUCKETS);
+          }
+
+          static value_type upperBound (std::size_t i)
+          {
+            if (i < SUB_BUCKETS) return (value_type) i;
+            const int shift = (int) (i / SUB_BUCKETS) - 1;
+            const value_type sub = (value_type) (i % SUB_BUCKETS);
+            return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+          }
+
+        private:
+          std::vector <value_type> counts_;
+          value_type count_;
+          value_type sum_;
+          value_type max_;
+      }; // class LatencyHistogram
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_LATENCY_HISTOGRAM_HH
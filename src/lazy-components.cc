@@ -0,0 +1,298 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#include "lazy-components.hh"
+
+#include <list>
+
+#include <hpp/util/debug.hh>
+#include <hpp/util/pointer.hh>
+
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/graph/edge.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/graph-component.hh>
+
+#include "graph-initializer.hh"
+#include "projection-cache.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      struct LazyComponents::Entry
+      {
+        /// Ids of the components, the most recently used first.
+        typedef std::list <std::size_t> Lru_t;
+        struct Built {
+          graph::GraphComponentWkPtr_t component;
+          Lru_t::iterator position;
+        };
+
+        Entry (const std::string& name) : name (name), lazy (false),
+          capacity (0), deferred (false), threads (0), completing (false),
+          active (0), building (false), materialized (0), evicted (0)
+        {}
+
+        const std::string name;
+        bool lazy;
+        std::size_t capacity;
+
+        bool deferred;
+        graph::GraphWkPtr_t graph;
+        std::size_t threads;
+        /// Whether defer or complete is initializing the graph.
+        bool completing;
+        /// Number of uses in progress.
+        std::size_t active;
+
+        /// Components initialized on demand.
+        Lru_t lru;
+        std::map <std::size_t, Built> built;
+        /// Whether a use is initializing a component.
+        bool building;
+
+        std::size_t materialized, evicted;
+      };
+
+      LazyComponents::Use::Use (LazyComponents& lazy,
+          const std::string& problemName, const graph::GraphPtr_t& graph,
+          const graph::GraphComponentPtr_t& component) :
+        lazy_ (lazy), entry_ (NULL)
+      {
+        if (!component || component == graph) return;
+        Lock_t lock (lazy.mutex_);
+        Entry& e = lazy.entry (problemName);
+        while (e.completing) lazy.changed_.wait (lock);
+        if (!e.deferred || e.graph.lock () != graph) return;
+        // Counted before waiting, so that the graph is not initialized
+        // again and no component is evicted meanwhile.
+        ++e.active;
+        entry_ = &e;
+        while (e.building) lazy.changed_.wait (lock);
+        const std::size_t id = component->id ();
+        std::map <std::size_t, Entry::Built>::iterator it = e.built.find (id);
+        if (it != e.built.end ()) {
+          e.lru.splice (e.lru.begin (), e.lru, it->second.position);
+          return;
+        }
+
+        e.building = true;
+        lock.unlock ();
+        try {
+          component->initialize ();
+        } catch (const std::exception&) {
+          lock.lock ();
+          e.building = false;
+          --e.active;
+          entry_ = NULL;
+          lazy.changed_.notify_all ();
+          throw;
+        }
+        lock.lock ();
+        e.building = false;
+        Entry::Built b;
+        b.component = component;
+        b.position = e.lru.insert (e.lru.begin (), id);
+        e.built [id] = b;
+        ++e.materialized;
+        hppDout (info, "Initialized " << component->name () << " on demand");
+        lazy.changed_.notify_all ();
+      }
+
+      LazyComponents::Use::~Use ()
+      {
+        if (entry_ == NULL) return;
+        Lock_t lock (lazy_.mutex_);
+        --entry_->active;
+        lazy_.evict (*entry_);
+        lazy_.changed_.notify_all ();
+      }
+
+      LazyComponents::LazyComponents (ProjectionCache& projectionCache) :
+        projectionCache_ (projectionCache)
+      {}
+
+      LazyComponents::~LazyComponents ()
+      {
+        for (std::map <std::string, Entry*>::iterator it = entries_.begin ();
+            it != entries_.end (); ++it)
+          delete it->second;
+      }
+
+      void LazyComponents::configure (const std::string& problemName,
+          bool lazy, std::size_t capacity)
+      {
+        Lock_t lock (mutex_);
+        Entry& e = entry (problemName);
+        e.lazy = lazy;
+        e.capacity = capacity;
+        evict (e);
+      }
+
+      bool LazyComponents::lazy (const std::string& problemName)
+      {
+        Lock_t lock (mutex_);
+        return entry (problemName).lazy;
+      }
+
+      void LazyComponents::defer (const std::string& problemName,
+          const ProblemSolverPtr_t& problemSolver, std::size_t threads)
+      {
+        Lock_t lock (mutex_);
+        Entry& e = entry (problemName);
+        waitIdle (lock, e);
+        e.completing = true;
+        e.deferred = false;
+        e.graph.reset ();
+        e.lru.clear ();
+        e.built.clear ();
+        lock.unlock ();
+        const graph::GraphPtr_t graph = problemSolver->constraintGraph ();
+        try {
+          // The components initialized on demand read what
+          // initConstraintGraph prepares.
+          GraphInitializer::prepare (problemSolver);
+          // The constraints may have changed since the components were
+          // initialized.
+          for (std::size_t i = 0; i < graph->nbComponents (); ++i) {
+            if (i == graph->id ()) continue;
+            graph::GraphComponentPtr_t c = graph->get (i).lock ();
+            if (c) c->invalidate ();
+          }
+        } catch (const std::exception&) {
+          lock.lock ();
+          e.completing = false;
+          changed_.notify_all ();
+          throw;
+        }
+        lock.lock ();
+        e.completing = false;
+        e.deferred = true;
+        e.graph = graph;
+        e.threads = threads;
+        e.materialized = e.evicted = 0;
+        changed_.notify_all ();
+      }
+
+      bool LazyComponents::complete (const std::string& problemName,
+          const ProblemSolverPtr_t& problemSolver)
+      {
+        Lock_t lock (mutex_);
+        Entry& e = entry (problemName);
+        waitIdle (lock, e);
+        graph::GraphPtr_t graph = e.graph.lock ();
+        if (!e.deferred || !graph || graph != problemSolver->constraintGraph ())
+          return false;
+        e.completing = true;
+        lock.unlock ();
+        try {
+          GraphInitializer::initialize (problemSolver, e.threads);
+        } catch (const std::exception&) {
+          lock.lock ();
+          e.completing = false;
+          changed_.notify_all ();
+          throw;
+        }
+        lock.lock ();
+        e.completing = false;
+        e.deferred = false;
+        e.graph.reset ();
+        e.lru.clear ();
+        e.built.clear ();
+        changed_.notify_all ();
+        hppDout (info, "Completed the initialization of the graph of "
+            << problemName);
+        return true;
+      }
+
+      void LazyComponents::forget (const std::string& problemName)
+      {
+        Lock_t lock (mutex_);
+        Entry& e = entry (problemName);
+        waitIdle (lock, e);
+        e.deferred = false;
+        e.graph.reset ();
+        e.lru.clear ();
+        e.built.clear ();
+      }
+
+      LazyComponents::Stats LazyComponents::stats
+      (const std::string& problemName)
+      {
+        Lock_t lock (mutex_);
+        const Entry& e = entry (problemName);
+        Stats s;
+        s.materialized = e.materialized;
+        s.evicted = e.evicted;
+        s.resident = e.built.size ();
+        s.deferred = e.deferred;
+        return s;
+      }
+
+      LazyComponents::Entry& LazyComponents::entry
+      (const std::string& problemName)
+      {
+        Entry*& e = entries_ [problemName];
+        if (e == NULL) e = new Entry (problemName);
+        return *e;
+      }
+
+      void LazyComponents::waitIdle (Lock_t& lock, Entry& e)
+      {
+        while (e.active > 0 || e.completing) changed_.wait (lock);
+      }
+
+      void LazyComponents::evict (Entry& e)
+      {
+        // The constraints of a component may be read by the initialization
+        // or the use of another one: a waypoint edge uses its inner edges.
+        if (e.capacity == 0 || e.active > 0 || e.completing) return;
+        Entry::Lru_t::iterator it = e.lru.end ();
+        bool edgeEvicted = false;
+        while (e.built.size () > e.capacity && it != e.lru.begin ()) {
+          --it;
+          graph::GraphComponentPtr_t c = e.built [*it].component.lock ();
+          // A level set edge would register its histogram in the graph
+          // again.
+          if (HPP_DYNAMIC_PTR_CAST (graph::LevelSetEdge, c)) continue;
+          if (c) {
+            c->invalidate ();
+            if (HPP_DYNAMIC_PTR_CAST (graph::Edge, c)) edgeEvicted = true;
+          }
+          projectionCache_.forget (e.name, *it);
+          e.built.erase (*it);
+          it = e.lru.erase (it);
+          ++e.evicted;
+        }
+        if (!edgeEvicted) return;
+        // The waypoint edges may use the evicted edge.
+        for (it = e.lru.begin (); it != e.lru.end ();) {
+          graph::GraphComponentPtr_t c = e.built [*it].component.lock ();
+          if (!HPP_DYNAMIC_PTR_CAST (graph::WaypointEdge, c)) {
+            ++it;
+            continue;
+          }
+          c->invalidate ();
+          projectionCache_.forget (e.name, *it);
+          e.built.erase (*it);
+          it = e.lru.erase (it);
+          ++e.evicted;
+        }
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
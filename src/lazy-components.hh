@@ -0,0 +1,146 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+
+#ifndef HPP_MANIPULATION_CORBA_LAZY_COMPONENTS_HH
+# define HPP_MANIPULATION_CORBA_LAZY_COMPONENTS_HH
+
+# include <map>
+# include <set>
+# include <string>
+
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/condition_variable.hpp>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      class ProjectionCache;
+
+      /// Components of the constraint graphs built on demand.
+      ///
+      /// When a problem is lazy, the initialization of its graph is
+      /// deferred: each state or edge is initialized the first time its
+      /// constraints are used, through a Use. Beyond a capacity, the least
+      /// recently used components are evicted: they are invalidated, their
+      /// cached projections are dropped, and they are built again when they
+      /// are used. Operations visiting the whole graph complete the
+      /// initialization first.
+      ///
+      /// Components are initialized on demand one at a time, as waypoint
+      /// edges initialize their inner edges and level set edges register
+      /// their histogram in the graph. For the same reasons, components are
+      /// evicted only while none is in use, evicting an edge evicts the
+      /// waypoint edges, and level set edges are never evicted.
+      class LazyComponents
+      {
+        public:
+          struct Stats {
+            /// Components initialized on demand.
+            std::size_t materialized;
+            /// Components evicted because of the capacity.
+            std::size_t evicted;
+            /// Components currently initialized on demand.
+            std::size_t resident;
+            /// Whether the initialization of the graph is deferred.
+            bool deferred;
+          };
+
+        private:
+          struct Entry;
+
+        public:
+          /// Initialize a component, if the graph is deferred, and prevent
+          /// the graph from being initialized again while the Use exists.
+          class Use
+          {
+            public:
+              /// \param component ignored if NULL or if it is the graph,
+              ///        so that callers can check its type afterwards.
+              /// \throw std::exception if the component fails to
+              ///        initialize.
+              Use (LazyComponents& lazy, const std::string& problemName,
+                  const graph::GraphPtr_t& graph,
+                  const graph::GraphComponentPtr_t& component);
+
+              ~Use ();
+
+            private:
+              LazyComponents& lazy_;
+              Entry* entry_;
+          }; // class Use
+
+          /// \param projectionCache where the projections of the evicted
+          ///        components are dropped.
+          LazyComponents (ProjectionCache& projectionCache);
+
+          ~LazyComponents ();
+
+          /// Set whether the graph of a problem is initialized on demand,
+          /// and the maximal number of components initialized on demand,
+          /// 0 for no limit.
+          void configure (const std::string& problemName, bool lazy,
+              std::size_t capacity);
+
+          bool lazy (const std::string& problemName);
+
+          /// Defer the initialization of the graph of a problem solver.
+          /// Initializes its steering method, registers its constraints in
+          /// the graph, invalidates the components and resets the
+          /// statistics.
+          /// \param threads number of threads of the initialization when it
+          ///        is completed, 0 for the number of cores.
+          void defer (const std::string& problemName,
+              const ProblemSolverPtr_t& problemSolver, std::size_t threads);
+
+          /// Initialize the components not initialized yet and the graph of
+          /// the problem solver, if its initialization was deferred.
+          /// \return whether the initialization was deferred.
+          bool complete (const std::string& problemName,
+              const ProblemSolverPtr_t& problemSolver);
+
+          /// Stop tracking the components of a problem, which is being
+          /// initialized entirely.
+          void forget (const std::string& problemName);
+
+          Stats stats (const std::string& problemName);
+
+        private:
+          typedef boost::mutex::scoped_lock Lock_t;
+
+          Entry& entry (const std::string& problemName);
+
+          /// Wait until no component of the entry is in use.
+          void waitIdle (Lock_t& lock, Entry& e);
+
+          /// Evict the least recently used components beyond the capacity,
+          /// if none is in use.
+          void evict (Entry& e);
+
+          ProjectionCache& projectionCache_;
+          boost::mutex mutex_;
+          boost::condition_variable changed_;
+          // Entries are never erased: the uses keep pointers to them.
+          std::map <std::string, Entry*> entries_;
+      }; // class LazyComponents
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_LAZY_COMPONENTS_HH
@@ -0,0 +1,178 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "metrics.hh"
+
+#include <time.h>
+
+#include <boost/thread/once.hpp>
+#include <boost/thread/tss.hpp>
+
+#include <omniORB4/CORBA.h>
+#include <omniORB4/omniInterceptors.h>
+
+#include "versions.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        void noCleanup (ServerMetrics::Call*) {}
+
+        /// Call being dispatched by the current thread.
+        boost::thread_specific_ptr <ServerMetrics::Call> current (noCleanup);
+
+        CORBA::Boolean onReceiveRequest
+        (omniInterceptors::serverReceiveRequest_T::info_T&)
+        {
+          if (current.get () != NULL) current->argumentsReceived ();
+          return true;
+        }
+
+        CORBA::Boolean onSendReply
+        (omniInterceptors::serverSendReply_T::info_T&)
+        {
+          if (current.get () != NULL) current->replyStarted ();
+          Versions::Update::replyStarted ();
+          return true;
+        }
+
+        CORBA::Boolean onSendException
+        (omniInterceptors::serverSendException_T::info_T&)
+        {
+          if (current.get () != NULL) current->replyStarted ();
+          Versions::Update::replyStarted ();
+          return true;
+        }
+
+        void addInterceptors ()
+        {
+          omniInterceptors* interceptors = omniORB::getInterceptors ();
+          interceptors->serverReceiveRequest.add (onReceiveRequest);
+          interceptors->serverSendReply.add (onSendReply);
+          interceptors->serverSendException.add (onSendException);
+        }
+
+        boost::once_flag interceptorsFlag = BOOST_ONCE_INIT;
+      }
+
+      ServerMetrics::Call::Call (ServerMetrics& metrics,
+          const char* interfaceName, const char* operation) :
+        metrics_ (metrics), interface_ (interfaceName), operation_ (operation),
+        previous_ (current.get ()), failed_ (false), discarded_ (false),
+        start_ (now ()), received_ (0), replied_ (0)
+      {
+        current.reset (this);
+      }
+
+      ServerMetrics::Call::~Call ()
+      {
+        current.reset (previous_);
+        if (discarded_) return;
+        const value_type end = now ();
+        // Without interceptor events (collocated call), everything is compute.
+        const value_type received = (received_ != 0 ? received_ : start_);
+        const value_type replied = (replied_ != 0 ? replied_ : end);
+
+        Record* r = metrics_.record (interface_, operation_);
+        boost::mutex::scoped_lock lock (r->mutex);
+        Operation& op = r->operation;
+        ++op.calls;
+        if (failed_) ++op.errors;
+        op.unmarshal.record (received - start_);
+        op.compute.record (replied - received);
+        op.marshal.record (end - replied);
+        op.total.record (end - start_);
+      }
+
+      void ServerMetrics::Call::argumentsReceived ()
+      {
+        if (received_ == 0) received_ = now ();
+      }
+
+      void ServerMetrics::Call::replyStarted ()
+      {
+        if (replied_ == 0) replied_ = now ();
+      }
+
+      ServerMetrics::ServerMetrics ()
+      {
+        installInterceptors ();
+      }
+
+      ServerMetrics::~ServerMetrics ()
+      {
+        for (Records_t::iterator it = records_.begin ();
+            it != records_.end (); ++it)
+          delete it->second;
+      }
+
+      ServerMetrics::Operations_t ServerMetrics::snapshot (bool reset)
+      {
+        Operations_t ops;
+        boost::mutex::scoped_lock lock (mutex_);
+        ops.reserve (records_.size ());
+        for (Records_t::iterator it = records_.begin ();
+            it != records_.end (); ++it) {
+          boost::mutex::scoped_lock recordLock (it->second->mutex);
+          Operation& op = it->second->operation;
+          if (op.calls == 0) continue;
+          ops.push_back (op);
+          if (reset) {
+            op.calls = op.errors = 0;
+            op.unmarshal.reset ();
+            op.compute.reset ();
+            op.marshal.reset ();
+            op.total.reset ();
+          }
+        }
+        return ops;
+      }
+
+      void ServerMetrics::reset ()
+      {
+        snapshot (true);
+      }
+
+      void ServerMetrics::installInterceptors ()
+      {
+        boost::call_once (addInterceptors, interceptorsFlag);
+      }
+
+      ServerMetrics::value_type ServerMetrics::now ()
+      {
+        struct timespec ts;
+        clock_gettime (CLOCK_MONOTONIC, &ts);
+        return (value_type) ts.tv_sec * 1000000000 + (value_type) ts.tv_nsec;
+      }
+
+      ServerMetrics::Record* ServerMetrics::record (const char* interfaceName,
+          const char* operation)
+      {
+        std::string name (interfaceName);
+        name += '.';
+        name += operation;
+        boost::mutex::scoped_lock lock (mutex_);
+        Records_t::iterator it = records_.find (name);
+        if (it != records_.end ()) return it->second;
+        Record* r = new Record;
+        r->operation.name = name;
+        records_.insert (std::make_pair (name, r));
+        return r;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,133 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_METRICS_HH
+# define HPP_MANIPULATION_CORBA_METRICS_HH
+
+# include <map>
+# include <string>
+# include <vector>
+
+# include <boost/thread/mutex.hpp>
+
+# include "latency-histogram.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Per-operation statistics of the manipulation servants.
+      ///
+      /// Each remote call is split in three phases:
+      /// \li unmarshal: from the dispatch of the request to the servant
+      ///     until the arguments are decoded,
+      /// \li compute: execution of the servant method,
+      /// \li marshal: encoding of the reply or of the exception.
+      ///
+      /// Phases are delimited by omniORB server interceptors. For collocated
+      /// calls, which bypass GIOP, the whole call is accounted as compute.
+      /// Exceptions are encoded after the dispatch returns, so the marshal
+      /// phase of failed calls is not measured.
+      class ServerMetrics
+      {
+        public:
+          typedef LatencyHistogram::value_type value_type;
+
+          struct Operation {
+            std::string name;
+            value_type calls;
+            value_type errors;
+            LatencyHistogram unmarshal;
+            LatencyHistogram compute;
+            LatencyHistogram marshal;
+            LatencyHistogram total;
+
+            Operation () : calls (0), errors (0) {}
+          };
+          typedef std::vector <Operation> Operations_t;
+
+          /// Measure one call to a servant operation.
+          ///
+          /// Create an instance on the stack of the servant dispatch method.
+          class Call
+          {
+            public:
+              Call (ServerMetrics& metrics, const char* interfaceName,
+                  const char* operation);
+              ~Call ();
+
+              /// The operation raised an exception.
+              void failed ()
+              {
+                failed_ = true;
+              }
+
+              /// The request was not for this servant, do not record it.
+              void discard ()
+              {
+                discarded_ = true;
+              }
+
+              /// Called by the interceptors of the current thread.
+              void argumentsReceived ();
+              void replyStarted ();
+
+            private:
+              ServerMetrics& metrics_;
+              const char* interface_;
+              const char* operation_;
+              Call* previous_;
+              bool failed_;
+              bool discarded_;
+              value_type start_, received_, replied_;
+          }; // class Call
+
+          ServerMetrics ();
+          ~ServerMetrics ();
+
+          /// Copy of the statistics of the operations called at least once.
+          /// \param reset whether to reset the statistics after the copy.
+          Operations_t snapshot (bool reset);
+
+          void reset ();
+
+          /// Register the omniORB interceptors, once.
+          ///
+          /// Called by the constructor, which is too late when another
+          /// server already initialized the ORB. Programs that initialize
+          /// the ORB themselves call it before, as hpp-manipulation-server
+          /// does.
+          static void installInterceptors ();
+
+          /// Monotonic time in nanoseconds.
+          static value_type now ();
+
+        private:
+          struct Record {
+            boost::mutex mutex;
+            Operation operation;
+          };
+          typedef std::map <std::string, Record*> Records_t;
+
+          Record* record (const char* interfaceName, const char* operation);
+
+          boost::mutex mutex_;
+          Records_t records_;
+      }; // class ServerMetrics
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_METRICS_HH
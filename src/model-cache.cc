@@ -0,0 +1,766 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "model-cache.hh"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <hpp/fcl/BVH/BVH_model.h>
+#include <hpp/fcl/mesh_loader/loader.h>
+#include <hpp/fcl/shape/geometric_shapes.h>
+
+#include <hpp/util/debug.hh>
+
+#include "metrics.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        typedef boost::uint64_t uint64;
+        typedef fcl::BVHModel <fcl::OBBRSS> Mesh_t;
+
+        // Increment when the format of the entries changes.
+        const char magic [8] = { 'H', 'P', 'P', 'E', 'N', 'V', '0', '1' };
+        // Increment when the copies of the meshes change.
+        const char meshMagic [8] = { 'H', 'P', 'P', 'M', 'S', 'H', '0', '1' };
+
+        enum GeometryType {
+          MESH = 0,
+          BOX = 1,
+          SPHERE = 2,
+          CYLINDER = 3,
+          CAPSULE = 4,
+          CONE = 5
+        };
+
+        /// 64-bit FNV-1a.
+        struct Hash {
+          uint64 value;
+
+          Hash () : value (14695981039346656037ULL) {}
+
+          void add (const char* data, std::size_t n)
+          {
+            for (std::size_t i = 0; i < n; ++i) {
+              value ^= (unsigned char) data[i];
+              value *= 1099511628211ULL;
+            }
+          }
+
+          void add (const std::string& s)
+          {
+            uint64 n = s.size ();
+            add (reinterpret_cast <const char*> (&n), sizeof (n));
+            add (s.data (), s.size ());
+          }
+
+          std::string str () const
+          {
+            std::ostringstream oss;
+            oss << std::hex << std::setw (16) << std::setfill ('0') << value;
+            return oss.str ();
+          }
+        };
+
+        /// Values of the filename attributes of a URDF description.
+        std::vector <std::string> meshFiles (const std::string& urdf)
+        {
+          std::vector <std::string> files;
+          const std::string attr ("filename=");
+          std::string::size_type pos = 0;
+          while ((pos = urdf.find (attr, pos)) != std::string::npos) {
+            pos += attr.size ();
+            if (pos >= urdf.size ()) break;
+            const char quote = urdf [pos];
+            if (quote != '"' && quote != '\'') continue;
+            std::string::size_type end = urdf.find (quote, pos + 1);
+            if (end == std::string::npos) break;
+            files.push_back (urdf.substr (pos + 1, end - pos - 1));
+            pos = end + 1;
+          }
+          return files;
+        }
+
+        /// Position of the value of an attribute.
+        struct Attribute {
+          std::string::size_type begin, end;
+        };
+
+        /// Filename attributes of the meshes of the collision elements of a
+        /// URDF description.
+        std::vector <Attribute> collisionMeshes (const std::string& urdf)
+        {
+          std::vector <Attribute> meshes;
+          std::string::size_type pos = 0;
+          while ((pos = urdf.find ("<collision", pos)) != std::string::npos) {
+            std::string::size_type end = urdf.find ("</collision>", pos);
+            if (end == std::string::npos) break;
+            std::string::size_type mesh = pos;
+            while ((mesh = urdf.find ("<mesh", mesh)) < end) {
+              const std::string::size_type close = urdf.find ('>', mesh);
+              std::string::size_type attr = urdf.find ("filename=", mesh);
+              mesh = close;
+              if (attr >= close) continue;
+              attr += std::string ("filename=").size ();
+              const char quote = urdf [attr];
+              if (quote != '"' && quote != '\'') continue;
+              Attribute a;
+              a.begin = attr + 1;
+              a.end = urdf.find (quote, a.begin);
+              if (a.end >= close) continue;
+              meshes.push_back (a);
+            }
+            pos = end;
+          }
+          return meshes;
+        }
+
+        // Serialization in the native byte order: entries are meant to be
+        // read on the host that wrote them.
+        template <typename T> void serialize (std::ostream& os, const T& v)
+        {
+          os.write (reinterpret_cast <const char*> (&v), sizeof (T));
+        }
+
+        void serialize (std::ostream& os, const std::string& s)
+        {
+          serialize (os, (uint64) s.size ());
+          os.write (s.data (), s.size ());
+        }
+
+        template <typename T> void deserialize (std::istream& is, T& v)
+        {
+          if (!is.read (reinterpret_cast <char*> (&v), sizeof (T)))
+            throw std::runtime_error ("truncated entry");
+        }
+
+        void deserialize (std::istream& is, std::string& s)
+        {
+          uint64 n; deserialize (is, n);
+          if (n > (1 << 20)) throw std::runtime_error ("corrupted entry");
+          s.resize ((std::size_t) n);
+          if (n > 0 && !is.read (&s[0], (std::streamsize) n))
+            throw std::runtime_error ("truncated entry");
+        }
+
+        uint64 readSize (std::istream& is)
+        {
+          uint64 n; deserialize (is, n);
+          if (n > (1ULL << 32)) throw std::runtime_error ("corrupted entry");
+          return n;
+        }
+
+        void serialize (std::ostream& os, const fcl::Transform3f& M)
+        {
+          const fcl::Matrix3f& R = M.getRotation ();
+          const fcl::Vec3f& T = M.getTranslation ();
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) serialize (os, (double) R (i, j));
+          for (int i = 0; i < 3; ++i) serialize (os, (double) T [i]);
+        }
+
+        void deserialize (std::istream& is, fcl::Transform3f& M)
+        {
+          fcl::Matrix3f R; fcl::Vec3f T; double v;
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) { deserialize (is, v); R (i, j) = v; }
+          for (int i = 0; i < 3; ++i) { deserialize (is, v); T [i] = v; }
+          M = fcl::Transform3f (R, T);
+        }
+
+        void serialize (std::ostream& os, const Transform3f& M)
+        {
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) serialize (os, (double) M.rotation () (i, j));
+          for (int i = 0; i < 3; ++i) serialize (os, (double) M.translation () [i]);
+        }
+
+        void deserialize (std::istream& is, Transform3f& M)
+        {
+          matrix3_t R; vector3_t T; double v;
+          for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j) { deserialize (is, v); R (i, j) = v; }
+          for (int i = 0; i < 3; ++i) { deserialize (is, v); T [i] = v; }
+          M = Transform3f (R, T);
+        }
+
+        /// \return false if the type of geometry is not supported.
+        bool serialize (std::ostream& os, const fcl::CollisionGeometry& g)
+        {
+          switch (g.getNodeType ()) {
+            case fcl::BV_OBBRSS: {
+              const Mesh_t* m = dynamic_cast <const Mesh_t*> (&g);
+              if (m == NULL) return false;
+              serialize (os, (boost::uint32_t) MESH);
+              serialize (os, (uint64) m->num_vertices);
+              for (int i = 0; i < m->num_vertices; ++i)
+                for (int j = 0; j < 3; ++j)
+                  serialize (os, (double) m->vertices [i][j]);
+              serialize (os, (uint64) m->num_tris);
+              for (int i = 0; i < m->num_tris; ++i)
+                for (int j = 0; j < 3; ++j)
+                  serialize (os, (uint64) m->tri_indices [i][j]);
+              return true;
+            }
+            case fcl::GEOM_BOX: {
+              const fcl::Box& b = static_cast <const fcl::Box&> (g);
+              serialize (os, (boost::uint32_t) BOX);
+              for (int j = 0; j < 3; ++j) serialize (os, (double) b.side [j]);
+              return true;
+            }
+            case fcl::GEOM_SPHERE:
+              serialize (os, (boost::uint32_t) SPHERE);
+              serialize (os, (double) static_cast <const fcl::Sphere&> (g).radius);
+              return true;
+            case fcl::GEOM_CYLINDER: {
+              const fcl::Cylinder& c = static_cast <const fcl::Cylinder&> (g);
+              serialize (os, (boost::uint32_t) CYLINDER);
+              serialize (os, (double) c.radius);
+              serialize (os, (double) c.lz);
+              return true;
+            }
+            case fcl::GEOM_CAPSULE: {
+              const fcl::Capsule& c = static_cast <const fcl::Capsule&> (g);
+              serialize (os, (boost::uint32_t) CAPSULE);
+              serialize (os, (double) c.radius);
+              serialize (os, (double) c.lz);
+              return true;
+            }
+            case fcl::GEOM_CONE: {
+              const fcl::Cone& c = static_cast <const fcl::Cone&> (g);
+              serialize (os, (boost::uint32_t) CONE);
+              serialize (os, (double) c.radius);
+              serialize (os, (double) c.lz);
+              return true;
+            }
+            default:
+              return false;
+          }
+        }
+
+        /// Triangles read from an entry, of which the BVH is not built yet.
+        struct PendingMesh {
+          std::size_t obstacle;
+          std::vector <fcl::Vec3f> vertices;
+          std::vector <fcl::Triangle> triangles;
+          double seconds;
+          std::string error;
+        };
+        typedef std::vector <PendingMesh> PendingMeshes_t;
+
+        /// \return NULL for a mesh, which is appended to pending.
+        EnvironmentModel::GeometryPtr_t readGeometry (std::istream& is,
+            PendingMeshes_t& pending)
+        {
+          boost::uint32_t type; deserialize (is, type);
+          double a, b, c;
+          switch (type) {
+            case MESH: {
+              pending.push_back (PendingMesh ());
+              PendingMesh& mesh = pending.back ();
+              std::vector <fcl::Vec3f>& vertices = mesh.vertices;
+              vertices.resize ((std::size_t) readSize (is));
+              for (std::size_t i = 0; i < vertices.size (); ++i) {
+                deserialize (is, a); deserialize (is, b); deserialize (is, c);
+                vertices [i] = fcl::Vec3f (a, b, c);
+              }
+              std::vector <fcl::Triangle>& triangles = mesh.triangles;
+              triangles.resize ((std::size_t) readSize (is));
+              for (std::size_t i = 0; i < triangles.size (); ++i) {
+                uint64 t [3];
+                for (int j = 0; j < 3; ++j) {
+                  deserialize (is, t[j]);
+                  if (t[j] >= vertices.size ())
+                    throw std::runtime_error ("corrupted entry");
+                }
+                triangles [i] = fcl::Triangle ((std::size_t) t[0],
+                    (std::size_t) t[1], (std::size_t) t[2]);
+              }
+              return EnvironmentModel::GeometryPtr_t ();
+            }
+            case BOX:
+              deserialize (is, a); deserialize (is, b); deserialize (is, c);
+              return EnvironmentModel::GeometryPtr_t (new fcl::Box (a, b, c));
+            case SPHERE:
+              deserialize (is, a);
+              return EnvironmentModel::GeometryPtr_t (new fcl::Sphere (a));
+            case CYLINDER:
+              deserialize (is, a); deserialize (is, b);
+              return EnvironmentModel::GeometryPtr_t (new fcl::Cylinder (a, b));
+            case CAPSULE:
+              deserialize (is, a); deserialize (is, b);
+              return EnvironmentModel::GeometryPtr_t (new fcl::Capsule (a, b));
+            case CONE:
+              deserialize (is, a); deserialize (is, b);
+              return EnvironmentModel::GeometryPtr_t (new fcl::Cone (a, b));
+            default:
+              throw std::runtime_error ("corrupted entry");
+          }
+        }
+
+        /// Build the BVHs of meshes [next, end), shared with other workers.
+        struct MeshBuilder {
+          PendingMeshes_t& meshes;
+          std::vector <EnvironmentModel::GeometryPtr_t>& geometries;
+          std::size_t& next;
+          boost::mutex& mutex;
+
+          void operator() ()
+          {
+            while (true) {
+              std::size_t i;
+              {
+                boost::mutex::scoped_lock lock (mutex);
+                if (next >= meshes.size ()) return;
+                i = next++;
+              }
+              PendingMesh& m = meshes[i];
+              const ServerMetrics::value_type start = ServerMetrics::now ();
+              try {
+                boost::shared_ptr <Mesh_t> mesh (new Mesh_t);
+                mesh->beginModel ((int) m.triangles.size (),
+                    (int) m.vertices.size ());
+                mesh->addSubModel (m.vertices, m.triangles);
+                mesh->endModel ();
+                geometries[i] = mesh;
+              } catch (const std::exception& e) {
+                m.error = e.what ();
+              }
+              m.seconds = 1e-9 * (double) (ServerMetrics::now () - start);
+            }
+          }
+        };
+
+        /// Build the BVHs in parallel. Each mesh is built independently
+        /// and assigned to its obstacle, so the result does not depend on
+        /// the number of threads nor on the scheduling.
+        void buildMeshes (PendingMeshes_t& meshes, EnvironmentModel& env)
+        {
+          std::vector <EnvironmentModel::GeometryPtr_t>
+            geometries (meshes.size ());
+          std::size_t next = 0;
+          boost::mutex mutex;
+          MeshBuilder builder = { meshes, geometries, next, mutex };
+          std::size_t n = std::min <std::size_t>
+            (std::max (boost::thread::hardware_concurrency (), 1u),
+             meshes.size ());
+          boost::thread_group workers;
+          // The calling thread is one of the workers.
+          for (std::size_t i = 1; i < n; ++i)
+            workers.create_thread (builder);
+          builder ();
+          workers.join_all ();
+          for (std::size_t i = 0; i < meshes.size (); ++i) {
+            if (!meshes[i].error.empty ())
+              throw std::runtime_error (meshes[i].error);
+            env.obstacles [meshes[i].obstacle].geometry = geometries[i];
+          }
+        }
+
+        /// A mesh file copied into the cache.
+        struct ImportedMesh {
+          std::string uri;
+          /// Path of the mesh file.
+          std::string file;
+          /// Path of the copy.
+          std::string copy;
+          std::size_t triangles;
+          double seconds;
+          std::string error;
+        };
+        typedef std::vector <ImportedMesh> ImportedMeshes_t;
+
+        /// Write the triangles of a mesh as a binary STL file.
+        /// \return false if the file cannot be written.
+        bool writeStl (const std::string& path, const fcl::BVHModelBase& mesh)
+        {
+          std::ostringstream tmp;
+          tmp << path << "." << ::getpid () << "."
+            << boost::this_thread::get_id () << ".tmp";
+          {
+            std::ofstream os (tmp.str ().c_str (), std::ios::binary);
+            if (!os) return false;
+            // A binary STL header must not start with "solid".
+            char header [80] = "hpp-manipulation-corba model cache";
+            os.write (header, sizeof (header));
+            serialize (os, (boost::uint32_t) mesh.num_tris);
+            for (int i = 0; i < mesh.num_tris; ++i) {
+              // The normals are not read by hpp-fcl.
+              for (int j = 0; j < 3; ++j) serialize (os, 0.f);
+              for (int j = 0; j < 3; ++j) {
+                const fcl::Vec3f& v = mesh.vertices [mesh.tri_indices [i][j]];
+                for (int k = 0; k < 3; ++k) serialize (os, (float) v [k]);
+              }
+              serialize (os, (boost::uint16_t) 0);
+            }
+            if (!os) {
+              os.close ();
+              std::remove (tmp.str ().c_str ());
+              return false;
+            }
+          }
+          // Parsers see either no copy or a complete one.
+          return std::rename (tmp.str ().c_str (), path.c_str ()) == 0;
+        }
+
+        /// Import a mesh and write its copy.
+        void importMesh (ImportedMesh& m)
+        {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
+          try {
+            // The scale of the URDF description is applied by the parser,
+            // to the copy.
+            fcl::MeshLoader loader (fcl::BV_OBBRSS);
+            fcl::BVHModelPtr_t mesh = loader.load (m.file,
+                fcl::Vec3f (1, 1, 1));
+            m.triangles = (std::size_t) mesh->num_tris;
+            if (!writeStl (m.copy, *mesh)) m.error = "cannot write " + m.copy;
+          } catch (const std::exception& e) {
+            m.error = e.what ();
+          }
+          m.seconds = 1e-9 * (double) (ServerMetrics::now () - start);
+        }
+
+        /// Import meshes [next, end), shared with other workers.
+        struct MeshImporter {
+          ImportedMeshes_t& meshes;
+          std::size_t& next;
+          boost::mutex& mutex;
+
+          void operator() ()
+          {
+            while (true) {
+              std::size_t i;
+              {
+                boost::mutex::scoped_lock lock (mutex);
+                if (next >= meshes.size ()) return;
+                i = next++;
+              }
+              importMesh (meshes[i]);
+            }
+          }
+        };
+
+        /// Import the meshes in parallel.
+        void importMeshes (ImportedMeshes_t& meshes)
+        {
+          std::size_t next = 0;
+          boost::mutex mutex;
+          MeshImporter importer = { meshes, next, mutex };
+          std::size_t n = std::min <std::size_t>
+            (std::max (boost::thread::hardware_concurrency (), 1u),
+             meshes.size ());
+          boost::thread_group workers;
+          // The calling thread is one of the workers.
+          for (std::size_t i = 1; i < n; ++i)
+            workers.create_thread (importer);
+          importer ();
+          workers.join_all ();
+        }
+
+        void serialize (std::ostream& os, const EnvironmentModel::Frame& f)
+        {
+          serialize (os, f.name);
+          serialize (os, f.position);
+          serialize (os, (double) f.clearance);
+        }
+
+        void deserialize (std::istream& is, EnvironmentModel::Frame& f)
+        {
+          double clearance;
+          deserialize (is, f.name);
+          deserialize (is, f.position);
+          deserialize (is, clearance);
+          f.clearance = clearance;
+        }
+      }
+
+      ModelCache::ModelCache (const std::string& directory) :
+        directory_ (directory), hits_ (0), misses_ (0)
+      {}
+
+      void ModelCache::directory (const std::string& directory)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        directory_ = directory;
+      }
+
+      std::string ModelCache::directory () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return directory_;
+      }
+
+      bool ModelCache::resolve (const std::string& uri, std::string& path)
+      {
+        std::vector <std::string> candidates;
+        const std::string package ("package://"), file ("file://");
+        if (uri.compare (0, package.size (), package) == 0) {
+          const char* env = std::getenv ("ROS_PACKAGE_PATH");
+          std::istringstream dirs (env ? env : "");
+          std::string dir;
+          while (std::getline (dirs, dir, ':'))
+            if (!dir.empty ())
+              candidates.push_back (dir + "/" + uri.substr (package.size ()));
+        } else if (uri.compare (0, file.size (), file) == 0) {
+          candidates.push_back (uri.substr (file.size ()));
+        } else {
+          candidates.push_back (uri);
+        }
+        for (std::size_t i = 0; i < candidates.size (); ++i) {
+          std::ifstream is (candidates[i].c_str (), std::ios::binary);
+          if (!is) continue;
+          path = candidates[i];
+          return true;
+        }
+        return false;
+      }
+
+      bool ModelCache::read (const std::string& uri, std::string& content)
+      {
+        std::string path;
+        if (!resolve (uri, path)) return false;
+        std::ifstream is (path.c_str (), std::ios::binary);
+        if (!is) return false;
+        std::ostringstream oss;
+        oss << is.rdbuf ();
+        content = oss.str ();
+        return true;
+      }
+
+      std::string ModelCache::key (const std::string& urdf,
+          const std::string& srdf, const std::string& rootJointType) const
+      {
+        Hash h;
+        h.add (std::string (magic, sizeof (magic)));
+        h.add (rootJointType);
+        h.add (urdf);
+        h.add (srdf);
+        std::vector <std::string> files = meshFiles (urdf);
+        for (std::size_t i = 0; i < files.size (); ++i) {
+          std::string content;
+          h.add (files[i]);
+          // A missing mesh is part of the key, as the parser skips it.
+          if (read (files[i], content)) h.add (content);
+          else h.add (std::string ("<missing>"));
+        }
+        return h.str ();
+      }
+
+      std::string ModelCache::path (const std::string& key) const
+      {
+        return directory () + "/" + key + ".env";
+      }
+
+      bool ModelCache::load (const std::string& key, EnvironmentModel& model,
+          LoadTimes_t* times)
+      {
+        if (!enabled ()) return false;
+        std::ifstream is (path (key).c_str (), std::ios::binary);
+        bool found = false;
+        if (is) {
+          try {
+            char m [sizeof (magic)];
+            if (!is.read (m, sizeof (m))
+                || !std::equal (m, m + sizeof (m), magic))
+              throw std::runtime_error ("not an entry");
+            EnvironmentModel env;
+            PendingMeshes_t pending;
+            env.obstacles.resize ((std::size_t) readSize (is));
+            for (std::size_t i = 0; i < env.obstacles.size (); ++i) {
+              deserialize (is, env.obstacles[i].name);
+              deserialize (is, env.obstacles[i].position);
+              env.obstacles[i].geometry = readGeometry (is, pending);
+              if (!env.obstacles[i].geometry)
+                pending.back ().obstacle = i;
+            }
+            env.contacts.resize ((std::size_t) readSize (is));
+            for (std::size_t i = 0; i < env.contacts.size (); ++i) {
+              deserialize (is, env.contacts[i].first);
+              std::vector <Shape_t>& shapes = env.contacts[i].second;
+              shapes.resize ((std::size_t) readSize (is));
+              for (std::size_t j = 0; j < shapes.size (); ++j) {
+                shapes[j].resize ((std::size_t) readSize (is));
+                for (std::size_t k = 0; k < shapes[j].size (); ++k)
+                  for (int l = 0; l < 3; ++l) {
+                    double v; deserialize (is, v); shapes[j][k][l] = v;
+                  }
+              }
+            }
+            env.handles.resize ((std::size_t) readSize (is));
+            for (std::size_t i = 0; i < env.handles.size (); ++i)
+              deserialize (is, env.handles[i]);
+            env.grippers.resize ((std::size_t) readSize (is));
+            for (std::size_t i = 0; i < env.grippers.size (); ++i)
+              deserialize (is, env.grippers[i]);
+            buildMeshes (pending, env);
+            if (times != NULL) {
+              times->clear ();
+              for (std::size_t i = 0; i < pending.size (); ++i) {
+                LoadTime t;
+                t.name = env.obstacles [pending[i].obstacle].name;
+                t.triangles = pending[i].triangles.size ();
+                t.seconds = pending[i].seconds;
+                times->push_back (t);
+              }
+            }
+            model = env;
+            found = true;
+          } catch (const std::exception& e) {
+            hppDout (warning, "Ignoring model cache entry " << key << ": "
+                << e.what ());
+          }
+        }
+        boost::mutex::scoped_lock lock (mutex_);
+        if (found) ++hits_;
+        else ++misses_;
+        return found;
+      }
+
+      bool ModelCache::store (const std::string& key,
+          const EnvironmentModel& model)
+      {
+        if (!enabled ()) return false;
+        std::ostringstream tmp;
+        tmp << path (key) << "." << ::getpid () << ".tmp";
+        {
+          std::ofstream os (tmp.str ().c_str (), std::ios::binary);
+          if (!os) return false;
+          os.write (magic, sizeof (magic));
+          serialize (os, (uint64) model.obstacles.size ());
+          for (std::size_t i = 0; i < model.obstacles.size (); ++i) {
+            serialize (os, model.obstacles[i].name);
+            serialize (os, model.obstacles[i].position);
+            if (!serialize (os, *model.obstacles[i].geometry)) {
+              hppDout (info, "Model not cached: unsupported geometry for "
+                  << model.obstacles[i].name);
+              os.close ();
+              std::remove (tmp.str ().c_str ());
+              return false;
+            }
+          }
+          serialize (os, (uint64) model.contacts.size ());
+          for (std::size_t i = 0; i < model.contacts.size (); ++i) {
+            serialize (os, model.contacts[i].first);
+            const std::vector <Shape_t>& shapes = model.contacts[i].second;
+            serialize (os, (uint64) shapes.size ());
+            for (std::size_t j = 0; j < shapes.size (); ++j) {
+              serialize (os, (uint64) shapes[j].size ());
+              for (std::size_t k = 0; k < shapes[j].size (); ++k)
+                for (int l = 0; l < 3; ++l)
+                  serialize (os, (double) shapes[j][k][l]);
+            }
+          }
+          serialize (os, (uint64) model.handles.size ());
+          for (std::size_t i = 0; i < model.handles.size (); ++i)
+            serialize (os, model.handles[i]);
+          serialize (os, (uint64) model.grippers.size ());
+          for (std::size_t i = 0; i < model.grippers.size (); ++i)
+            serialize (os, model.grippers[i]);
+          if (!os) {
+            os.close ();
+            std::remove (tmp.str ().c_str ());
+            return false;
+          }
+        }
+        // Readers see either no entry or a complete one.
+        return std::rename (tmp.str ().c_str (), path (key).c_str ()) == 0;
+      }
+
+      bool ModelCache::cacheMeshes (std::string& urdf, LoadTimes_t* times)
+      {
+        if (times != NULL) times->clear ();
+        if (!enabled ()) return false;
+        const std::vector <Attribute> attributes = collisionMeshes (urdf);
+        // Paths of the copies, by URI.
+        std::map <std::string, std::string> copies;
+        ImportedMeshes_t missing;
+        for (std::size_t i = 0; i < attributes.size (); ++i) {
+          const std::string uri = urdf.substr (attributes[i].begin,
+              attributes[i].end - attributes[i].begin);
+          if (copies.count (uri)) continue;
+          ImportedMesh m;
+          std::string content;
+          if (!resolve (uri, m.file) || !read (m.file, content)) {
+            hppDout (info, "Meshes not cached: cannot read " << uri);
+            return false;
+          }
+          Hash h;
+          h.add (std::string (meshMagic, sizeof (meshMagic)));
+          // The importer chooses the format after the extension.
+          h.add (uri.substr (std::min (uri.rfind ('.'), uri.size ())));
+          h.add (content);
+          m.uri = uri;
+          m.copy = directory () + "/" + h.str () + ".stl";
+          m.triangles = 0;
+          m.seconds = 0;
+          copies [uri] = m.copy;
+          if (!std::ifstream (m.copy.c_str (), std::ios::binary))
+            missing.push_back (m);
+        }
+        importMeshes (missing);
+        for (std::size_t i = 0; i < missing.size (); ++i) {
+          if (!missing[i].error.empty ()) {
+            hppDout (warning, "Meshes not cached: " << missing[i].uri << ": "
+                << missing[i].error);
+            return false;
+          }
+          if (times != NULL) {
+            LoadTime t;
+            t.name = missing[i].uri;
+            t.triangles = missing[i].triangles;
+            t.seconds = missing[i].seconds;
+            times->push_back (t);
+          }
+        }
+        // From the end, so that the positions of the other attributes do
+        // not change.
+        for (std::size_t i = attributes.size (); i-- > 0;) {
+          const Attribute& a = attributes[i];
+          urdf.replace (a.begin, a.end - a.begin,
+              "file://" + copies [urdf.substr (a.begin, a.end - a.begin)]);
+        }
+        hppDout (info, copies.size () - missing.size () << " meshes read from "
+            "the cache, " << missing.size () << " imported");
+        return true;
+      }
+
+      std::size_t ModelCache::hits () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return hits_;
+      }
+
+      std::size_t ModelCache::misses () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return misses_;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,124 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_MODEL_CACHE_HH
+# define HPP_MANIPULATION_CORBA_MODEL_CACHE_HH
+
+# include <string>
+# include <vector>
+
+# include <boost/thread/mutex.hpp>
+
+# include "environment-model.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// On-disk cache of environment models and of meshes.
+      ///
+      /// An entry is keyed by a hash of the content of the URDF and SRDF
+      /// descriptions, of the mesh files they reference and of the root
+      /// joint type. Names are not prefixed, so that an entry is shared by
+      /// all the prefixes. It stores the geometries, as
+      /// triangles for meshes, their positions, the contact surfaces and
+      /// the handles and grippers, so that loading an unchanged model does
+      /// not parse the descriptions nor the mesh files.
+      ///
+      /// Meshes are stored as BVHModel<OBBRSS>, the type built by the URDF
+      /// parser. Models with other kinds of geometries, except boxes,
+      /// spheres, cylinders, capsules and cones, are not cached.
+      ///
+      /// Robots, objects and humanoids are inserted in the device as
+      /// kinematic trees by the URDF parser of hpp-pinocchio, which builds
+      /// their geometries itself and cannot be given prebuilt ones. For
+      /// them, and for the environments not cached yet, the cache keeps a
+      /// copy of each collision mesh, as a binary STL file keyed by a hash
+      /// of the content of the mesh file: the parser reads the copy, which
+      /// is quick to import whatever the format of the original file, and
+      /// still builds the BVHs.
+      class ModelCache
+      {
+        public:
+          /// \param directory where the entries are stored. The cache is
+          ///        disabled if empty.
+          ModelCache (const std::string& directory = "");
+
+          void directory (const std::string& directory);
+
+          std::string directory () const;
+
+          bool enabled () const
+          {
+            return !directory ().empty ();
+          }
+
+          /// Read a resource.
+          /// \param uri a path, or an URI starting with file:// or with
+          ///        package://, searched in ROS_PACKAGE_PATH.
+          /// \return false if the resource cannot be read.
+          static bool read (const std::string& uri, std::string& content);
+
+          /// Find a resource.
+          /// \param uri as in read.
+          /// \return false if the resource cannot be read.
+          static bool resolve (const std::string& uri, std::string& path);
+
+          /// Compute the key of a model.
+          std::string key (const std::string& urdf, const std::string& srdf,
+              const std::string& rootJointType) const;
+
+          struct LoadTime {
+            std::string name;
+            std::size_t triangles;
+            double seconds;
+          };
+          typedef std::vector <LoadTime> LoadTimes_t;
+
+          /// The BVHs of the meshes are built by a pool of threads.
+          /// \param times if not NULL, filled with the time spent building
+          ///        the BVH of each mesh, in the order of the obstacles.
+          /// \return false if there is no valid entry for this key.
+          bool load (const std::string& key, EnvironmentModel& model,
+              LoadTimes_t* times = NULL);
+
+          /// \return false if the model cannot be stored.
+          bool store (const std::string& key, const EnvironmentModel& model);
+
+          /// Make the meshes of the collision elements of a URDF description
+          /// refer to their copies. The missing copies are imported by a
+          /// pool of threads.
+          /// \param times if not NULL, filled with the time spent importing
+          ///        each mesh that had no copy.
+          /// \return false if the cache is disabled or if a mesh cannot be
+          ///         read or copied. urdf is then unchanged.
+          bool cacheMeshes (std::string& urdf, LoadTimes_t* times = NULL);
+
+          std::size_t hits () const;
+
+          std::size_t misses () const;
+
+        private:
+          std::string path (const std::string& key) const;
+
+          mutable boost::mutex mutex_;
+          std::string directory_;
+          std::size_t hits_, misses_;
+      }; // class ModelCache
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_MODEL_CACHE_HH
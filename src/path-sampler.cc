@@ -0,0 +1,109 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "path-sampler.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <hpp/util/pointer.hh>
+#include <hpp/manipulation/constraint-set.hh>
+#include <hpp/manipulation/graph/edge.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      PathSampler::PathSampler (const core::PathVectorPtr_t& path) :
+        flat_ (core::PathVector::create (path->outputSize (),
+              path->outputDerivativeSize ())), rank_ (0)
+      {
+        path->flatten (flat_);
+        const std::size_t n = flat_->numberPaths ();
+        starts_.resize (n + 1);
+        edgeIds_.resize (n, -1);
+        starts_ [0] = flat_->timeRange ().first;
+        for (std::size_t r = 0; r < n; ++r) {
+          core::PathPtr_t p = flat_->pathAtRank (r);
+          starts_ [r + 1] = starts_ [r] + p->length ();
+          ConstraintSetPtr_t c =
+            HPP_DYNAMIC_PTR_CAST (ConstraintSet, p->constraints ());
+          if (c && c->edge ()) edgeIds_ [r] = (long) c->edge ()->id ();
+        }
+      }
+
+      std::size_t PathSampler::rankAtParam (value_type param,
+          value_type& local)
+      {
+        const std::size_t n = edgeIds_.size ();
+        if (n == 0 || param < starts_.front () || param > starts_.back ()) {
+          std::ostringstream oss;
+          oss << "Parameter " << param << " out of range ["
+            << starts_.front () << ", " << starts_.back () << "]";
+          throw std::out_of_range (oss.str ());
+        }
+        if (param < starts_ [rank_]) {
+          rank_ = std::upper_bound (starts_.begin (), starts_.end (), param)
+            - starts_.begin () - 1;
+          rank_ = std::min (rank_, n - 1);
+        } else {
+          while (rank_ + 1 < n && param >= starts_ [rank_ + 1]) ++rank_;
+        }
+        local = flat_->pathAtRank (rank_)->timeRange ().first
+          + (param - starts_ [rank_]);
+        return rank_;
+      }
+
+      std::size_t PathSampler::configAtParam (value_type param,
+          core::ConfigurationOut_t q)
+      {
+        value_type local;
+        std::size_t r = rankAtParam (param, local);
+        if (!(*flat_->pathAtRank (r)) (q, local)) {
+          std::ostringstream oss;
+          oss << "Failed to evaluate the path at " << param;
+          throw std::runtime_error (oss.str ());
+        }
+        return r;
+      }
+
+      void PathSampler::velocityAtParam (value_type param, core::vectorOut_t v)
+      {
+        value_type local;
+        std::size_t r = rankAtParam (param, local);
+        flat_->pathAtRank (r)->derivative (v, local, 1);
+      }
+
+      std::vector <PathSampler::value_type> PathSampler::params
+      (value_type step) const
+      {
+        if (!(step > 0)) {
+          std::ostringstream oss;
+          oss << "Step must be positive: " << step;
+          throw std::invalid_argument (oss.str ());
+        }
+        const value_type first = starts_.front (), last = starts_.back ();
+        const std::size_t n =
+          1 + (std::size_t) std::ceil ((last - first) / step);
+        std::vector <value_type> p (n);
+        for (std::size_t i = 0; i < n; ++i)
+          p [i] = std::min (first + (value_type) i * step, last);
+        return p;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
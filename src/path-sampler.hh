@@ -0,0 +1,93 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_PATH_SAMPLER_HH
+# define HPP_MANIPULATION_CORBA_PATH_SAMPLER_HH
+
+# include <vector>
+
+# include <hpp/core/fwd.hh>
+# include <hpp/core/path-vector.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Evaluation of a path at many parameters.
+      ///
+      /// The path is flattened once. Evaluating at increasing parameters
+      /// walks the elementary paths in a single pass; a smaller parameter
+      /// restarts with a binary search.
+      class PathSampler
+      {
+        public:
+          typedef core::value_type value_type;
+          typedef core::size_type size_type;
+
+          PathSampler (const core::PathVectorPtr_t& path);
+
+          const core::interval_t& timeRange () const
+          {
+            return flat_->timeRange ();
+          }
+
+          size_type configSize () const
+          {
+            return flat_->outputSize ();
+          }
+
+          size_type velocitySize () const
+          {
+            return flat_->outputDerivativeSize ();
+          }
+
+          /// Configuration at a parameter.
+          /// \return the rank of the elementary path containing the
+          ///         parameter.
+          /// \throw std::out_of_range if the parameter is outside the time
+          ///        range, std::runtime_error if the evaluation fails.
+          std::size_t configAtParam (value_type param,
+              core::ConfigurationOut_t q);
+
+          /// Velocity at a parameter.
+          void velocityAtParam (value_type param, core::vectorOut_t v);
+
+          /// Id of the edge of the constraint graph that generated an
+          /// elementary path, -1 if it is not known.
+          long edgeId (std::size_t rank) const
+          {
+            return edgeIds_ [rank];
+          }
+
+          /// Parameters from the beginning of the path with a fixed step,
+          /// and the end of the path.
+          std::vector <value_type> params (value_type step) const;
+
+        private:
+          /// Rank of the elementary path and parameter in this path.
+          std::size_t rankAtParam (value_type param, value_type& local);
+
+          core::PathVectorPtr_t flat_;
+          /// Parameter of the beginning of each elementary path, and end of
+          /// the path.
+          std::vector <value_type> starts_;
+          std::vector <long> edgeIds_;
+          std::size_t rank_;
+      }; // class PathSampler
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_PATH_SAMPLER_HH
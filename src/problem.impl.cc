@@ -17,11 +17,14 @@
 
 #include "problem.impl.hh"
 
+#include <cmath>
+
 #include <hpp/corbaserver/manipulation/server.hh>
 #include <hpp/corbaserver/conversions.hh>
 
 #include <boost/algorithm/string/case_conv.hpp>
 #include <boost/assign/list_of.hpp>
+#include <boost/bind.hpp>
 
 #include <hpp/util/debug.hh>
 #include <hpp/core/roadmap.hh>
@@ -43,7 +46,19 @@
 #include <hpp/manipulation/axial-handle.hh>
 #include <hpp/manipulation/steering-method/graph.hh>
 
+#include "batch-validation.hh"
+#include "lazy-components.hh"
+#include "metrics.hh"
+#include "path-sampler.hh"
+#include "projection-cache.hh"
+#include "roadmap-index.hh"
+#include "roadmap-io.hh"
+#include "scene-assemblies.hh"
+#include "scheduler.hh"
+#include "solve-jobs.hh"
+#include "state-sampler.hh"
 #include "tools.hh"
+#include "versions.hh"
 
 namespace hpp {
   namespace manipulation {
@@ -99,12 +114,96 @@ namespace hpp {
           }
           return jointNames;
         }
+
+        SolveStatus* toSolveStatus (const SolveJob::Status& s)
+        {
+          SolveStatus* status = new SolveStatus ();
+          status->state = SolveJob::toString (s.state).c_str ();
+          status->iterations = (ULong) s.iterations;
+          status->nbNodes = (ULong) s.nbNodes;
+          status->nbEdges = (ULong) s.nbEdges;
+          status->nbConnectedComponents = (ULong) s.nbConnectedComponents;
+          status->elapsed = s.elapsed;
+          status->pathId = (CORBA::Long) s.pathId;
+          status->error = s.error.c_str ();
+          return status;
+        }
+
+        void toLatencySummary (const LatencyHistogram& h,
+            corbaserver::manipulation::LatencySummary& out)
+        {
+          // Histograms are in nanoseconds.
+          out.mean = h.mean () * 1e-3;
+          out.p50  = (double) h.quantile (.5  ) * 1e-3;
+          out.p90  = (double) h.quantile (.9  ) * 1e-3;
+          out.p99  = (double) h.quantile (.99 ) * 1e-3;
+          out.p999 = (double) h.quantile (.999) * 1e-3;
+          out.max  = (double) h.max () * 1e-3;
+        }
+
+        void writeNodes (const core::Nodes_t& nodes, size_type nq, double* data)
+        {
+          for (core::Nodes_t::const_iterator it = nodes.begin ();
+              it != nodes.end (); ++it, data += nq)
+            Eigen::Map <vector_t> (data, nq) = *(*it)->configuration ();
+        }
+
+        struct ParamLess {
+          const std::vector <value_type>& params;
+          ParamLess (const std::vector <value_type>& p) : params (p) {}
+          bool operator() (std::size_t i, std::size_t j) const
+          {
+            return params [i] < params [j];
+          }
+        };
+
+        void writePathSamples (PathSampler& sampler,
+            const std::vector <value_type>& params, double* data)
+        {
+          const size_type nq = sampler.configSize ();
+          for (std::size_t i = 0; i < params.size (); ++i, data += 1 + nq) {
+            data [0] = params [i];
+            Eigen::Map <vector_t> q (data + 1, nq);
+            sampler.configAtParam (params [i], q);
+          }
+        }
       }
 
       Problem::Problem () : server_ (0x0)
       {
       }
 
+      CORBA::Boolean Problem::_dispatch (omniCallHandle& handle)
+      {
+        server_->solveJobs ().checkIdle (dynamic_cast <ProblemSolverPtr_t>
+            (server_->problemSolverMap ()->selected ()), "Problem",
+            handle.operation_name ());
+        server_->sceneAssemblies ().checkAllowed
+          (server_->problemSolverMap ()->selected_, "Problem",
+           handle.operation_name ());
+        // Time spent waiting for admission is not part of the metrics of
+        // the operation.
+        impl::Scheduler::Ticket ticket (server_->scheduler (), "Problem",
+            handle.operation_name ());
+        impl::ServerMetrics::Call call (server_->metrics (), "Problem",
+            handle.operation_name ());
+        // Destroyed before call, so that the metrics include the update.
+        impl::Versions::Update update (*server_, "Problem",
+            handle.operation_name ());
+        try {
+          CORBA::Boolean found =
+            POA_hpp::corbaserver::manipulation::Problem::_dispatch (handle);
+          if (!found) {
+            call.discard ();
+            update.discard ();
+          }
+          return found;
+        } catch (...) {
+          call.failed ();
+          throw;
+        }
+      }
+
       ProblemSolverPtr_t Problem::problemSolver ()
       {
         return server_->problemSolver();
@@ -132,6 +231,13 @@ namespace hpp {
       void Problem::resetProblem () throw (hpp::Error)
       {
         corbaServer::ProblemSolverMapPtr_t psMap (server_->problemSolverMap());
+        if (server_->solveJobs ().isBusy (dynamic_cast <ProblemSolverPtr_t>
+              (psMap->map_ [ psMap->selected_ ])))
+          throw Error ("A planning job is running on this problem. "
+              "Cancel it before resetting the problem.");
+        server_->projectionSessions ().drop (psMap->selected_);
+        // The new problem has no scene assembly in progress.
+        server_->sceneAssemblies ().abort (psMap->selected_);
         delete psMap->map_ [ psMap->selected_ ];
         psMap->map_ [ psMap->selected_ ]
           = manipulation::ProblemSolver::create ();
@@ -357,6 +463,8 @@ namespace hpp {
           graph::GraphComponentPtr_t comp = graph()->get ((size_t)id).lock ();
           graph::EdgePtr_t edge = HPP_DYNAMIC_PTR_CAST(graph::Edge, comp);
           graph::StatePtr_t state = HPP_DYNAMIC_PTR_CAST(graph::State, comp);
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), comp);
           if (edge) {
             if (target)
               constraint = graph()->configConstraint (edge);
@@ -393,6 +501,8 @@ namespace hpp {
           graph::GraphComponentPtr_t comp = graph()->get ((size_t)id).lock ();
           graph::EdgePtr_t edge = HPP_DYNAMIC_PTR_CAST(graph::Edge, comp);
           graph::StatePtr_t state = HPP_DYNAMIC_PTR_CAST(graph::State, comp);
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), comp);
           if (edge) {
             constraint = graph(false)->configConstraint (edge);
             DevicePtr_t robot = getRobotOrThrow (problemSolver());
@@ -411,11 +521,42 @@ namespace hpp {
 	  bool success = false;
           DevicePtr_t robot = getRobotOrThrow (problemSolver());
 	  ConfigurationPtr_t config = floatSeqToConfigPtr (robot, input, true);
+	  hpp::core::ConfigProjectorPtr_t configProjector =
+	    constraint->configProjector ();
+
+          ProjectionCache& cache = server_->projectionCache ();
+          const bool cached = cache.enabled ();
+          const std::string& problemName =
+            server_->problemSolverMap ()->selected_;
+          Versions::Stamps stamps;
+          ProjectionCache::Key key;
+          ProjectionCache::Result result;
+          if (cached) {
+            stamps = server_->versions ().get (problemName);
+            key = configProjector
+              ? cache.key (ProjectionCache::PROJECTION, (std::size_t) id,
+                  *config, configProjector->rightHandSide (),
+                  configProjector->errorThreshold (),
+                  (std::size_t) configProjector->maxIterations ())
+              : cache.key (ProjectionCache::PROJECTION, (std::size_t) id,
+                  *config, vector_t (), 0, 0);
+            if (cache.find (problemName, stamps, key, result)) {
+              if (configProjector) residualError = result.residualError;
+              output = vectorToFloatSeq (result.value);
+              return result.success;
+            }
+          }
+
 	  success = constraint->apply (*config);
-	  if (hpp::core::ConfigProjectorPtr_t configProjector =
-	      constraint ->configProjector ()) {
+	  if (configProjector) {
 	    residualError = configProjector->residualError ();
 	  }
+          if (cached) {
+            result.value = *config;
+            result.success = success;
+            result.residualError = residualError;
+            cache.insert (problemName, stamps, key, result);
+          }
 	  output = vectorToFloatSeq(*config);
 	  return success;
 	} catch (const std::exception& exc) {
@@ -440,15 +581,18 @@ namespace hpp {
             std::string errmsg = ss.str();
             throw Error (errmsg.c_str());
           }
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), edge);
 	  bool success = false;
           DevicePtr_t robot = getRobotOrThrow (problemSolver());
 	  ConfigurationPtr_t config = floatSeqToConfigPtr (robot, input, true);
 	  ConfigurationPtr_t qoffset = floatSeqToConfigPtr (robot, qnear, true);
-          value_type dist = 0;
-          core::NodePtr_t nNode = problemSolver()->roadmap()->nearestNode
-	    (qoffset, dist);
-          if (dist < 1e-8)
-            success = edge->applyConstraints (nNode, *config);
+          RoadmapIndex::Neighbours_t nNodes =
+            server_->roadmapIndex ().withinRadius (problemSolver(),
+                server_->problemSolverMap ()->selected_, graph::StatePtr_t (),
+                core::ConnectedComponentPtr_t (), *qoffset, 1e-8);
+          if (!nNodes.empty ())
+            success = edge->applyConstraints (nNodes.front ().node, *config);
           else
             success = edge->applyConstraints (*qoffset, *config);
 
@@ -473,6 +617,144 @@ namespace hpp {
 	}
       }
 
+      intSeq* Problem::validateConfigurations (const hpp::floatSeqSeq& configs,
+          Names_t_out object1, Names_t_out object2)
+        throw (hpp::Error)
+      {
+        try {
+          const ULong rows = configs.length ();
+          const ULong cols = (rows > 0 ? configs[0].length () : 0);
+          matrix_t q (rows, cols);
+          for (ULong i = 0; i < rows; ++i) {
+            if (configs[i].length () != cols) {
+              HPP_THROW (Error, "Row " << i << " has " << configs[i].length ()
+                  << " values instead of " << cols);
+            }
+            for (ULong j = 0; j < cols; ++j) q (i, j) = configs[i][j];
+          }
+          BatchValidation::Results_t results =
+            BatchValidation::validate (problemSolver(), q);
+          std::vector <int> valid (results.size ());
+          std::vector <std::string> o1 (results.size ()), o2 (results.size ());
+          for (std::size_t i = 0; i < results.size (); ++i) {
+            valid[i] = results[i].valid;
+            o1[i] = results[i].object1;
+            o2[i] = results[i].object2;
+          }
+          object1 = toNames_t (o1.begin (), o1.end ());
+          object2 = toNames_t (o2.begin (), o2.end ());
+          return toIntSeq (valid.begin (), valid.end ());
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      ProjectionSessionPtr_t Problem::projectionSession (ID session)
+      {
+        if (session < 0) {
+          HPP_THROW (Error, "Wrong projection session id: " << session);
+        }
+        try {
+          return server_->projectionSessions ().get
+            (server_->problemSolverMap ()->selected_, (std::size_t) session);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      ID Problem::openProjectionSession (hpp::ID idComp)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          graph::GraphComponentPtr_t comp =
+            graph()->get ((size_t)idComp).lock ();
+          graph::EdgePtr_t edge = HPP_DYNAMIC_PTR_CAST(graph::Edge, comp);
+          graph::StatePtr_t state = HPP_DYNAMIC_PTR_CAST(graph::State, comp);
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), comp);
+          ConstraintSetPtr_t constraint;
+          if (edge) {
+            constraint = graph()->configConstraint (edge);
+            if (core::ConfigProjectorPtr_t cp = constraint->configProjector ())
+              cp->rightHandSideFromConfig (robot->currentConfiguration());
+          } else if (state) {
+            constraint = graph()->configConstraint (state);
+          } else {
+            HPP_THROW (Error, "ID " << idComp
+                << " is neither an edge nor a state");
+          }
+          ProjectionSessionPtr_t session (new ProjectionSession (robot,
+                constraint, problemSolver()->maxIterProjection ()));
+          return (ID) server_->projectionSessions ().open
+            (server_->problemSolverMap ()->selected_, session);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      bool Problem::projectInSession (ID session, const hpp::floatSeq& input,
+          hpp::floatSeq_out output, double& residualError, ULong& iterations)
+        throw (hpp::Error)
+      {
+        ProjectionSessionPtr_t s = projectionSession (session);
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          if (robot != s->robot ())
+            throw std::runtime_error ("The robot of the problem changed since"
+                " the projection session was opened");
+          ConfigurationPtr_t q = floatSeqToConfigPtr (robot, input, true);
+          Configuration_t result (q->size ());
+          std::size_t n;
+          bool success = s->project (*q, result, residualError, n);
+          iterations = (ULong) n;
+          output = vectorToFloatSeq (result);
+          return success;
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      void Problem::closeProjectionSession (ID session) throw (hpp::Error)
+      {
+        try {
+          server_->projectionSessions ().close
+            (server_->problemSolverMap ()->selected_, (std::size_t) session);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      floatSeqSeq* Problem::generateValidConfigsInState (hpp::ID stateId,
+          ULong n, Double timeBudget, intSeq_out attempts)
+        throw (hpp::Error)
+      {
+        try {
+          graph::StatePtr_t state = HPP_DYNAMIC_PTR_CAST (graph::State,
+              graph()->get ((size_t)stateId).lock ());
+          if (!state) {
+            HPP_THROW (Error, "ID " << stateId << " is not a state");
+          }
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), state);
+          StateSampler::Samples samples = StateSampler::sample
+            (problemSolver(), state, n, timeBudget);
+          floatSeqSeq_var configs = new floatSeqSeq ();
+          configs->length ((ULong) samples.configurations.size ());
+          for (std::size_t i = 0; i < samples.configurations.size (); ++i) {
+            const Configuration_t& q = samples.configurations[i];
+            configs[(ULong) i].length ((ULong) q.size ());
+            for (size_type j = 0; j < q.size (); ++j)
+              configs[(ULong) i][(ULong) j] = q[j];
+          }
+          attempts = toIntSeq (samples.attempts.begin (),
+              samples.attempts.end ());
+          return configs._retn ();
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
       bool Problem::buildAndProjectPath (hpp::ID IDedge,
           const hpp::floatSeq& qb,
           const hpp::floatSeq& qe,
@@ -497,6 +779,8 @@ namespace hpp {
 	      ->innerSteeringMethod()) {
 	    problemSolver ()->initSteeringMethod ();
 	  }
+          LazyComponents::Use use (server_->lazyComponents (),
+              server_->problemSolverMap ()->selected_, graph (), edge);
 	  bool success = false;
           DevicePtr_t robot = getRobotOrThrow (problemSolver());
 	  ConfigurationPtr_t q1 = floatSeqToConfigPtr (robot, qb, true);
@@ -595,6 +879,328 @@ namespace hpp {
 	  throw hpp::Error (exc.what ());
 	}
       }
+
+      floatSeq* Problem::samplePath (ULong pathId, Double step,
+          const floatSeq& params, CORBA::Boolean withVelocities,
+          floatSeqSeq_out configs, floatSeqSeq_out velocities,
+          intSeq_out edgeIds)
+        throw (hpp::Error)
+      {
+        try {
+          if (pathId >= problemSolver()->paths ().size ()) {
+            HPP_THROW (Error, "Wrong path id: " << pathId << ", number path: "
+                << problemSolver()->paths ().size () << ".");
+          }
+          PathSampler sampler (problemSolver()->paths () [pathId]);
+          std::vector <value_type> ts;
+          if (step > 0) ts = sampler.params (step);
+          else ts.assign (params.get_buffer (),
+              params.get_buffer () + params.length ());
+
+          // Evaluate in increasing order of parameter, so that the
+          // elementary paths are walked once.
+          std::vector <std::size_t> order (ts.size ());
+          for (std::size_t i = 0; i < order.size (); ++i) order [i] = i;
+          std::stable_sort (order.begin (), order.end (), ParamLess (ts));
+
+          const ULong n = (ULong) ts.size ();
+          const size_type nq = sampler.configSize (),
+                          nv = sampler.velocitySize ();
+          floatSeqSeq_var q = new floatSeqSeq ();
+          floatSeqSeq_var v = new floatSeqSeq ();
+          intSeq_var e = new intSeq ();
+          floatSeq_var t = new floatSeq ();
+          q->length (n);
+          v->length (withVelocities ? n : 0);
+          e->length (n);
+          t->length (n);
+          for (std::size_t k = 0; k < order.size (); ++k) {
+            const ULong i = (ULong) order [k];
+            t [i] = ts [i];
+            q [i].length ((ULong) nq);
+            Eigen::Map <vector_t> config (q [i].get_buffer (), nq);
+            std::size_t rank = sampler.configAtParam (ts [i], config);
+            if (withVelocities) {
+              v [i].length ((ULong) nv);
+              Eigen::Map <vector_t> velocity (v [i].get_buffer (), nv);
+              sampler.velocityAtParam (ts [i], velocity);
+            }
+            e [i] = (CORBA::Long) sampler.edgeId (rank);
+          }
+          configs = q._retn ();
+          velocities = v._retn ();
+          edgeIds = e._retn ();
+          return t._retn ();
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      SolveJobPtr_t Problem::solveJob (ID jobId)
+      {
+        if (jobId < 0) {
+          HPP_THROW (Error, "Wrong planning job id: " << jobId);
+        }
+        try {
+          return server_->solveJobs ().get ((std::size_t) jobId);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      ID Problem::startSolve () throw (hpp::Error)
+      {
+        try {
+          server_->lazyComponents ().complete
+            (server_->problemSolverMap ()->selected_, problemSolver ());
+          return (ID) server_->solveJobs ().start (problemSolver ())->id ();
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      void Problem::getSolveStatus (ID jobId, SolveStatus_out status)
+        throw (hpp::Error)
+      {
+        status = toSolveStatus (solveJob (jobId)->status ());
+      }
+
+      void Problem::getSolveEdgeStats (ID jobId, hpp::IDseq_out edgeIds,
+          Names_t_out reasons, intSeqSeq_out freqs)
+        throw (hpp::Error)
+      {
+        SolveJobPtr_t job = solveJob (jobId);
+        try {
+          // The planner is modified at each step of the job.
+          boost::mutex::scoped_lock lock (job->stepMutex ());
+          ManipulationPlannerPtr_t mp = HPP_DYNAMIC_PTR_CAST
+            (ManipulationPlanner, job->problemSolver ()->pathPlanner ());
+          if (!mp) throw Error ("The planner must be a ManipulationPlanner");
+          graph::GraphPtr_t g = job->problemSolver ()->constraintGraph ();
+          if (!g) throw Error ("You should create the graph");
+
+          std::vector <graph::EdgePtr_t> edges;
+          for (std::size_t i = 0; i < g->nbComponents (); ++i) {
+            graph::EdgePtr_t edge = HPP_DYNAMIC_PTR_CAST (graph::Edge,
+                g->get (i).lock ());
+            if (edge) edges.push_back (edge);
+          }
+
+          StringList_t errors = ManipulationPlanner::errorList ();
+          hpp::IDseq* ids = new hpp::IDseq ();
+          intSeqSeq* f = new intSeqSeq ();
+          ids->length ((ULong) edges.size ());
+          f->length ((ULong) edges.size ());
+          for (std::size_t i = 0; i < edges.size (); ++i) {
+            (*ids) [(ULong) i] = (ID) edges[i]->id ();
+            ManipulationPlanner::ErrorFreqs_t fes = mp->getEdgeStat (edges[i]);
+            intSeq& row = (*f) [(ULong) i];
+            row.length ((ULong) fes.size ());
+            for (std::size_t j = 0; j < fes.size (); ++j)
+              row [(ULong) j] = (CORBA::Long) fes[j];
+          }
+          edgeIds = ids;
+          reasons = toNames_t (errors.begin (), errors.end ());
+          freqs = f;
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      bool Problem::cancelSolve (ID jobId, Double deadline)
+        throw (hpp::Error)
+      {
+        return solveJob (jobId)->cancel (deadline);
+      }
+
+      bool Problem::waitSolve (ID jobId, Double timeout,
+          SolveStatus_out status)
+        throw (hpp::Error)
+      {
+        SolveJobPtr_t job = solveJob (jobId);
+        bool stopped = job->wait (timeout);
+        status = toSolveStatus (job->status ());
+        return stopped;
+      }
+
+      void Problem::getServerMetrics (bool reset,
+          OperationMetricsSeq_out metrics)
+        throw (hpp::Error)
+      {
+        using corbaserver::manipulation::OperationMetricsSeq;
+        ServerMetrics::Operations_t ops =
+          server_->metrics ().snapshot (reset);
+        OperationMetricsSeq* m = new OperationMetricsSeq ();
+        m->length ((ULong) ops.size ());
+        for (std::size_t i = 0; i < ops.size (); ++i) {
+          corbaserver::manipulation::OperationMetrics& om = (*m) [(ULong) i];
+          om.name = ops[i].name.c_str ();
+          om.calls = ops[i].calls;
+          om.errors = ops[i].errors;
+          toLatencySummary (ops[i].unmarshal, om.unmarshal);
+          toLatencySummary (ops[i].compute, om.compute);
+          toLatencySummary (ops[i].marshal, om.marshal);
+          toLatencySummary (ops[i].total, om.total);
+        }
+        metrics = m;
+      }
+
+      void Problem::resetServerMetrics () throw (hpp::Error)
+      {
+        server_->metrics ().reset ();
+      }
+
+      void Problem::getQueueMetrics (bool reset, QueueMetricsSeq_out queues)
+        throw (hpp::Error)
+      {
+        using corbaserver::manipulation::QueueMetricsSeq;
+        Scheduler::Queues_t qs = server_->scheduler ().snapshot (reset);
+        QueueMetricsSeq* m = new QueueMetricsSeq ();
+        m->length ((ULong) qs.size ());
+        for (std::size_t i = 0; i < qs.size (); ++i) {
+          corbaserver::manipulation::QueueMetrics& qm = (*m) [(ULong) i];
+          qm.name = qs[i].name.c_str ();
+          qm.slots = (ULong) qs[i].slots;
+          qm.bound = (ULong) qs[i].bound;
+          qm.running = (ULong) qs[i].running;
+          qm.depth = (ULong) qs[i].depth;
+          qm.maxDepth = (ULong) qs[i].maxDepth;
+          qm.admitted = qs[i].admitted;
+          qm.rejected = qs[i].rejected;
+          toLatencySummary (qs[i].wait, qm.wait);
+        }
+        queues = m;
+      }
+
+      void Problem::setProjectionCache (ULong capacity, Double quantum)
+        throw (hpp::Error)
+      {
+        try {
+          server_->projectionCache ().configure (capacity, quantum);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      void Problem::getProjectionCacheStats (bool reset,
+          CORBA::ULongLong& hits, CORBA::ULongLong& misses)
+        throw (hpp::Error)
+      {
+        ProjectionCache& cache = server_->projectionCache ();
+        hits = cache.hits ();
+        misses = cache.misses ();
+        if (reset) cache.resetCounters ();
+      }
+
+      SharedChannelPtr_t Problem::sharedChannel (ID channel)
+      {
+        if (channel < 0) {
+          HPP_THROW (Error, "Wrong shared channel id: " << channel);
+        }
+        try {
+          return sharedChannels_.get ((std::size_t) channel);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      ID Problem::openSharedChannel (CORBA::ULongLong capacity,
+          CORBA::String_out name, CORBA::ULongLong& size)
+        throw (hpp::Error)
+      {
+        try {
+          std::size_t id;
+          SharedChannelPtr_t channel =
+            sharedChannels_.open ((std::size_t) capacity, id);
+          name = CORBA::string_dup (channel->name ().c_str ());
+          size = channel->size ();
+          return (ID) id;
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      void Problem::closeSharedChannel (ID channel) throw (hpp::Error)
+      {
+        sharedChannel (channel);
+        sharedChannels_.close ((std::size_t) channel);
+      }
+
+      CORBA::ULongLong Problem::sendRoadmapNodes (ID channel)
+        throw (hpp::Error)
+      {
+        SharedChannelPtr_t c = sharedChannel (channel);
+        try {
+          const core::Nodes_t& nodes = problemSolver()->roadmap ()->nodes ();
+          const size_type nq = problemSolver()->robot ()->configSize ();
+          return c->write (corbaServer::manipulation::RECORD_CONFIGURATIONS,
+              nodes.size (), nq,
+              boost::bind (&writeNodes, boost::cref (nodes), nq, _1));
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      CORBA::ULongLong Problem::sendPathSamples (ID channel, ULong pathId,
+          Double step)
+        throw (hpp::Error)
+      {
+        SharedChannelPtr_t c = sharedChannel (channel);
+        try {
+          if (pathId >= problemSolver()->paths ().size ()) {
+            HPP_THROW (Error, "Wrong path id: " << pathId << ", number path: "
+                << problemSolver()->paths ().size () << ".");
+          }
+          PathSampler sampler (problemSolver()->paths () [pathId]);
+          const std::vector <value_type> params = sampler.params (step);
+          return c->write (corbaServer::manipulation::RECORD_PATH_SAMPLES,
+              params.size (), 1 + sampler.configSize (),
+              boost::bind (&writePathSamples, boost::ref (sampler),
+                boost::cref (params), _1));
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      void Problem::exportRoadmap (const char* filename) throw (hpp::Error)
+      {
+        try {
+          RoadmapIO::save (problemSolver (), filename);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      ULong Problem::importRoadmap (const char* filename, ULong& nbEdges,
+          ULong& nbSkippedEdges)
+        throw (hpp::Error)
+      {
+        try {
+          // The states of the nodes are computed.
+          server_->lazyComponents ().complete
+            (server_->problemSolverMap ()->selected_, problemSolver ());
+          std::size_t edges, skipped;
+          ULong nodes = (ULong) RoadmapIO::load (problemSolver (), filename,
+              edges, skipped);
+          nbEdges = (ULong) edges;
+          nbSkippedEdges = (ULong) skipped;
+          return nodes;
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      hpp::corbaserver::manipulation::Versions Problem::getVersions ()
+        throw (hpp::Error)
+      {
+        Versions::Stamps s = server_->versions ().get
+          (server_->problemSolverMap ()->selected_);
+        hpp::corbaserver::manipulation::Versions v;
+        v.problem = s.problem;
+        v.graph = s.graph;
+        v.robot = s.robot;
+        return v;
+      }
     } // namespace impl
   } // namespace manipulation
 } // namespace hpp
@@ -22,6 +22,10 @@
 # include <hpp/manipulation/problem-solver.hh>
 # include "hpp/corbaserver/manipulation/problem.hh"
 
+# include "solve-jobs.hh"
+# include "shared-channels.hh"
+# include "projection-sessions.hh"
+
 namespace hpp {
   namespace manipulation {
     namespace impl {
@@ -29,6 +33,10 @@ namespace hpp {
       using CORBA::UShort;
       using CORBA::ULong;
       using CORBA::Double;
+      using hpp::corbaserver::manipulation::SolveStatus;
+      using hpp::corbaserver::manipulation::SolveStatus_out;
+      using hpp::corbaserver::manipulation::OperationMetricsSeq_out;
+      using hpp::corbaserver::manipulation::QueueMetricsSeq_out;
 
       class Problem : public virtual POA_hpp::corbaserver::manipulation::Problem
       {
@@ -39,6 +47,9 @@ namespace hpp {
           server_ = server;
         }
 
+        /// Record the statistics of the call in Server::metrics.
+        virtual CORBA::Boolean _dispatch (omniCallHandle& handle);
+
         virtual bool selectProblem (const char* name) throw (hpp::Error);
 
         virtual void resetProblem () throw (hpp::Error);
@@ -92,6 +103,24 @@ namespace hpp {
             hpp::floatSeq_out output, double& residualError)
           throw (hpp::Error);
 
+        virtual intSeq* validateConfigurations (const hpp::floatSeqSeq& configs,
+            Names_t_out object1, Names_t_out object2)
+          throw (hpp::Error);
+
+        virtual ID openProjectionSession (hpp::ID idComp)
+          throw (hpp::Error);
+
+        virtual bool projectInSession (ID session, const hpp::floatSeq& input,
+            hpp::floatSeq_out output, double& residualError,
+            ULong& iterations)
+          throw (hpp::Error);
+
+        virtual void closeProjectionSession (ID session) throw (hpp::Error);
+
+        virtual floatSeqSeq* generateValidConfigsInState (hpp::ID stateId,
+            ULong n, Double timeBudget, intSeq_out attempts)
+          throw (hpp::Error);
+
         virtual bool buildAndProjectPath (hpp::ID IDedge,
             const hpp::floatSeq& qb,
             const hpp::floatSeq& qe,
@@ -104,10 +133,74 @@ namespace hpp {
         virtual ID edgeAtParam (ULong pathId, Double param)
           throw (Error);
 
+        virtual floatSeq* samplePath (ULong pathId, Double step,
+            const floatSeq& params, CORBA::Boolean withVelocities,
+            floatSeqSeq_out configs, floatSeqSeq_out velocities,
+            intSeq_out edgeIds)
+          throw (hpp::Error);
+
+        virtual ID startSolve () throw (hpp::Error);
+
+        virtual void getSolveStatus (ID jobId, SolveStatus_out status)
+          throw (hpp::Error);
+
+        virtual void getSolveEdgeStats (ID jobId, hpp::IDseq_out edgeIds,
+            Names_t_out reasons, intSeqSeq_out freqs)
+          throw (hpp::Error);
+
+        virtual bool cancelSolve (ID jobId, Double deadline)
+          throw (hpp::Error);
+
+        virtual bool waitSolve (ID jobId, Double timeout,
+            SolveStatus_out status)
+          throw (hpp::Error);
+
+        virtual void getServerMetrics (bool reset,
+            OperationMetricsSeq_out metrics)
+          throw (hpp::Error);
+
+        virtual void resetServerMetrics () throw (hpp::Error);
+
+        virtual void getQueueMetrics (bool reset, QueueMetricsSeq_out queues)
+          throw (hpp::Error);
+
+        virtual void setProjectionCache (ULong capacity, Double quantum)
+          throw (hpp::Error);
+
+        virtual void getProjectionCacheStats (bool reset,
+            CORBA::ULongLong& hits, CORBA::ULongLong& misses)
+          throw (hpp::Error);
+
+        virtual ID openSharedChannel (CORBA::ULongLong capacity,
+            CORBA::String_out name, CORBA::ULongLong& size)
+          throw (hpp::Error);
+
+        virtual void closeSharedChannel (ID channel) throw (hpp::Error);
+
+        virtual CORBA::ULongLong sendRoadmapNodes (ID channel)
+          throw (hpp::Error);
+
+        virtual CORBA::ULongLong sendPathSamples (ID channel, ULong pathId,
+            Double step)
+          throw (hpp::Error);
+
+        virtual void exportRoadmap (const char* filename) throw (hpp::Error);
+
+        virtual ULong importRoadmap (const char* filename, ULong& nbEdges,
+            ULong& nbSkippedEdges)
+          throw (hpp::Error);
+
+        virtual hpp::corbaserver::manipulation::Versions getVersions ()
+          throw (hpp::Error);
+
       private:
+        SolveJobPtr_t solveJob (ID jobId);
+        SharedChannelPtr_t sharedChannel (ID channel);
+        ProjectionSessionPtr_t projectionSession (ID session);
         ProblemSolverPtr_t problemSolver();
         graph::GraphPtr_t graph(bool throwIfNull = true);
         Server* server_;
+        SharedChannels sharedChannels_;
       }; // class Problem
     } // namespace impl
   } // namespace manipulation
@@ -0,0 +1,171 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "projection-cache.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        void quantize (const vectorIn_t& v, value_type quantum,
+            std::vector <boost::int64_t>& values)
+        {
+          for (size_type i = 0; i < v.size (); ++i)
+            values.push_back ((boost::int64_t) std::floor (v[i] / quantum
+                  + .5));
+        }
+      }
+
+      bool ProjectionCache::Key::operator< (const Key& other) const
+      {
+        if (kind != other.kind) return kind < other.kind;
+        if (component != other.component) return component < other.component;
+        if (errorThreshold != other.errorThreshold)
+          return errorThreshold < other.errorThreshold;
+        if (maxIterations != other.maxIterations)
+          return maxIterations < other.maxIterations;
+        return values < other.values;
+      }
+
+      ProjectionCache::ProjectionCache () :
+        capacity_ (0), quantum_ (1e-6), hits_ (0), misses_ (0)
+      {}
+
+      void ProjectionCache::configure (std::size_t capacity,
+          value_type quantum)
+      {
+        if (!(quantum > 0))
+          throw std::invalid_argument ("The quantum must be positive");
+        boost::mutex::scoped_lock lock (mutex_);
+        capacity_ = capacity;
+        quantum_ = quantum;
+        tables_.clear ();
+      }
+
+      bool ProjectionCache::enabled () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return capacity_ > 0;
+      }
+
+      ProjectionCache::Key ProjectionCache::key (Kind kind,
+          std::size_t component, ConfigurationIn_t input, vectorIn_t rhs,
+          value_type errorThreshold, std::size_t maxIterations) const
+      {
+        value_type quantum;
+        {
+          boost::mutex::scoped_lock lock (mutex_);
+          quantum = quantum_;
+        }
+        Key k;
+        k.kind = kind;
+        k.component = component;
+        k.errorThreshold = errorThreshold;
+        k.maxIterations = maxIterations;
+        k.values.reserve (input.size () + rhs.size ());
+        quantize (input, quantum, k.values);
+        quantize (rhs, quantum, k.values);
+        return k;
+      }
+
+      bool ProjectionCache::find (const std::string& problemName,
+          const Versions::Stamps& stamps, const Key& key, Result& result)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (capacity_ == 0) return false;
+        Component& c = table (problemName, stamps).components
+          [ComponentKey_t (key.kind, key.component)];
+        std::map <Key, Results_t::iterator>::iterator it = c.index.find (key);
+        if (it == c.index.end ()) {
+          ++misses_;
+          return false;
+        }
+        // Most recently used first.
+        c.results.splice (c.results.begin (), c.results, it->second);
+        result = it->second->second;
+        ++hits_;
+        return true;
+      }
+
+      void ProjectionCache::insert (const std::string& problemName,
+          const Versions::Stamps& stamps, const Key& key,
+          const Result& result)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (capacity_ == 0) return;
+        Component& c = table (problemName, stamps).components
+          [ComponentKey_t (key.kind, key.component)];
+        std::map <Key, Results_t::iterator>::iterator it = c.index.find (key);
+        if (it != c.index.end ()) {
+          it->second->second = result;
+          c.results.splice (c.results.begin (), c.results, it->second);
+          return;
+        }
+        c.results.push_front (std::make_pair (key, result));
+        c.index [key] = c.results.begin ();
+        while (c.results.size () > capacity_) {
+          c.index.erase (c.results.back ().first);
+          c.results.pop_back ();
+        }
+      }
+
+      void ProjectionCache::forget (const std::string& problemName,
+          std::size_t component)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        std::map <std::string, Table>::iterator it = tables_.find
+          (problemName);
+        if (it == tables_.end ()) return;
+        it->second.components.erase (ComponentKey_t (PROJECTION, component));
+        it->second.components.erase (ComponentKey_t (STATE_ERROR, component));
+      }
+
+      std::size_t ProjectionCache::hits () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return hits_;
+      }
+
+      std::size_t ProjectionCache::misses () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return misses_;
+      }
+
+      void ProjectionCache::resetCounters ()
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        hits_ = misses_ = 0;
+      }
+
+      ProjectionCache::Table& ProjectionCache::table
+      (const std::string& problemName, const Versions::Stamps& stamps)
+      {
+        Table& t = tables_ [problemName];
+        if (t.stamps.problem != stamps.problem
+            || t.stamps.graph != stamps.graph
+            || t.stamps.robot != stamps.robot) {
+          t.components.clear ();
+          t.stamps = stamps;
+        }
+        return t;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
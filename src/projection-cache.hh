@@ -0,0 +1,139 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_PROJECTION_CACHE_HH
+# define HPP_MANIPULATION_CORBA_PROJECTION_CACHE_HH
+
+# include <list>
+# include <map>
+# include <string>
+# include <vector>
+
+# include <boost/cstdint.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include <hpp/manipulation/fwd.hh>
+
+# include "versions.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Results of the projections on the constraints of the graph
+      /// components.
+      ///
+      /// Inputs are rounded to a multiple of a quantum, so that nearly
+      /// identical configurations share a result. Each component of each
+      /// problem keeps its most recently used results, up to a capacity.
+      /// The results of a problem are dropped when its version stamps
+      /// change. The parameters of the projector are part of the key.
+      ///
+      /// The cache is disabled until a capacity is set.
+      class ProjectionCache
+      {
+        public:
+          /// What was computed.
+          enum Kind {
+            /// Projection on the constraints of a state or an edge.
+            PROJECTION,
+            /// Error of a configuration with respect to a state.
+            STATE_ERROR
+          };
+
+          struct Key {
+            int kind;
+            std::size_t component;
+            /// Parameters of the projector.
+            value_type errorThreshold;
+            std::size_t maxIterations;
+            /// Quantized input configuration and right hand side.
+            std::vector <boost::int64_t> values;
+
+            bool operator< (const Key& other) const;
+          };
+
+          struct Result {
+            /// Projected configuration, or error.
+            vector_t value;
+            bool success;
+            value_type residualError;
+          };
+
+          ProjectionCache ();
+
+          /// Set the number of results kept per component, 0 to disable the
+          /// cache, and the quantum of the inputs. Drops all the results.
+          void configure (std::size_t capacity, value_type quantum);
+
+          bool enabled () const;
+
+          /// \param rhs right hand side of the constraints, empty if it is
+          ///        fixed,
+          /// \param errorThreshold, maxIterations parameters of the
+          ///        projector.
+          Key key (Kind kind, std::size_t component, ConfigurationIn_t input,
+              vectorIn_t rhs, value_type errorThreshold,
+              std::size_t maxIterations) const;
+
+          /// \return whether a result is stored for the key. Counts a hit or
+          ///         a miss.
+          bool find (const std::string& problemName,
+              const Versions::Stamps& stamps, const Key& key, Result& result);
+
+          void insert (const std::string& problemName,
+              const Versions::Stamps& stamps, const Key& key,
+              const Result& result);
+
+          /// Drop the results of a component of a problem.
+          void forget (const std::string& problemName, std::size_t component);
+
+          std::size_t hits () const;
+
+          std::size_t misses () const;
+
+          void resetCounters ();
+
+        private:
+          typedef std::list <std::pair <Key, Result> > Results_t;
+          struct Component {
+            Results_t results;
+            std::map <Key, Results_t::iterator> index;
+          };
+          typedef std::pair <int, std::size_t> ComponentKey_t;
+          struct Table {
+            Table ()
+            {
+              stamps.problem = stamps.graph = stamps.robot = 0;
+            }
+            Versions::Stamps stamps;
+            std::map <ComponentKey_t, Component> components;
+          };
+
+          /// Table of a problem, emptied if the stamps changed.
+          Table& table (const std::string& problemName,
+              const Versions::Stamps& stamps);
+
+          mutable boost::mutex mutex_;
+          std::size_t capacity_;
+          value_type quantum_;
+          std::map <std::string, Table> tables_;
+          std::size_t hits_, misses_;
+      }; // class ProjectionCache
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_PROJECTION_CACHE_HH
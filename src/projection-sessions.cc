@@ -0,0 +1,129 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "projection-sessions.hh"
+
+#include <sstream>
+#include <stdexcept>
+
+#include <hpp/util/pointer.hh>
+
+#include <hpp/pinocchio/configuration.hh>
+#include <hpp/pinocchio/device.hh>
+#include <hpp/core/config-projector.hh>
+#include <hpp/manipulation/constraint-set.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      ProjectionSession::ProjectionSession (const DevicePtr_t& robot,
+          const ConstraintSetPtr_t& constraint, std::size_t maxIterations) :
+        robot_ (robot), maxIterations_ (maxIterations), warm_ (false)
+      {
+        constraint_ = HPP_DYNAMIC_PTR_CAST (ConstraintSet,
+            constraint->copy ());
+        if (!constraint_)
+          throw std::runtime_error ("Cannot copy the constraints");
+        projector_ = constraint_->configProjector ();
+        if (projector_) projector_->maxIterations (1);
+      }
+
+      bool ProjectionSession::project (ConfigurationIn_t input,
+          ConfigurationOut_t output, value_type& residualError,
+          std::size_t& iterations)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Configuration_t q (input);
+        if (warm_) {
+          vector_t v (robot_->numberDof ());
+          hpp::pinocchio::difference (robot_, input, lastInput_, v);
+          hpp::pinocchio::integrate (robot_, lastOutput_, v, q);
+        }
+
+        bool success;
+        iterations = 0;
+        if (!projector_ || constraint_->isSatisfied (q)) {
+          // Locked joints only, or nothing to do.
+          success = constraint_->apply (q);
+        } else {
+          do {
+            ++iterations;
+            success = constraint_->apply (q);
+          } while (!success && iterations < maxIterations_);
+        }
+        residualError = (projector_ ? projector_->residualError () : 0);
+
+        warm_ = success;
+        if (success) {
+          lastInput_ = input;
+          lastOutput_ = q;
+        }
+        output = q;
+        return success;
+      }
+
+      ProjectionSessions::ProjectionSessions () : nextId_ (0)
+      {}
+
+      std::size_t ProjectionSessions::open (const std::string& problemName,
+          const ProjectionSessionPtr_t& session)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        std::size_t id = nextId_++;
+        sessions_ [id] = std::make_pair (problemName, session);
+        return id;
+      }
+
+      ProjectionSessionPtr_t ProjectionSessions::get
+      (const std::string& problemName, std::size_t id) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Sessions_t::const_iterator it = sessions_.find (id);
+        if (it == sessions_.end () || it->second.first != problemName) {
+          std::ostringstream oss;
+          oss << "No projection session with id " << id << " in problem "
+            << problemName;
+          throw std::out_of_range (oss.str ());
+        }
+        return it->second.second;
+      }
+
+      void ProjectionSessions::close (const std::string& problemName,
+          std::size_t id)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Sessions_t::iterator it = sessions_.find (id);
+        if (it == sessions_.end () || it->second.first != problemName) {
+          std::ostringstream oss;
+          oss << "No projection session with id " << id << " in problem "
+            << problemName;
+          throw std::out_of_range (oss.str ());
+        }
+        sessions_.erase (it);
+      }
+
+      void ProjectionSessions::drop (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        for (Sessions_t::iterator it = sessions_.begin ();
+            it != sessions_.end ();) {
+          if (it->second.first == problemName) sessions_.erase (it++);
+          else ++it;
+        }
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,121 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_PROJECTION_SESSIONS_HH
+# define HPP_MANIPULATION_CORBA_PROJECTION_SESSIONS_HH
+
+# include <map>
+# include <string>
+
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include <hpp/core/fwd.hh>
+# include <hpp/manipulation/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Projection of a stream of configurations on the constraints of
+      /// a graph component.
+      ///
+      /// Each projection starts from the previous solution, moved by the
+      /// displacement between the previous input and the new one. For
+      /// slowly varying inputs, the start is close to the solution and few
+      /// iterations are needed. The session projects with its own copy of
+      /// the constraints, which performs one iteration per call so that the
+      /// iterations are counted.
+      ///
+      /// Counting has a cost: each call evaluates the constraints at its
+      /// start point again, and the input is checked before the first call.
+      /// k iterations evaluate the constraints about 2k + 1 times, against
+      /// k + 1 for a single projection. The saving of the warm start is
+      /// measured by the number of iterations, not by the time.
+      class ProjectionSession
+      {
+        public:
+          /// \param constraint constraints of the component, copied.
+          /// \param maxIterations maximal number of iterations of a
+          ///        projection.
+          ProjectionSession (const DevicePtr_t& robot,
+              const ConstraintSetPtr_t& constraint,
+              std::size_t maxIterations);
+
+          /// \param[out] output the projected configuration, also when the
+          ///             projection fails.
+          /// \param[out] residualError norm of the error of the output.
+          /// \param[out] iterations number of iterations.
+          /// \return whether the projection succeeded. After a failure, the
+          ///         next projection starts from its input.
+          bool project (ConfigurationIn_t input, ConfigurationOut_t output,
+              value_type& residualError, std::size_t& iterations);
+
+          const DevicePtr_t& robot () const
+          {
+            return robot_;
+          }
+
+        private:
+          DevicePtr_t robot_;
+          ConstraintSetPtr_t constraint_;
+          core::ConfigProjectorPtr_t projector_;
+          std::size_t maxIterations_;
+          boost::mutex mutex_;
+          /// Whether the previous projection succeeded.
+          bool warm_;
+          Configuration_t lastInput_;
+          Configuration_t lastOutput_;
+      }; // class ProjectionSession
+      typedef boost::shared_ptr <ProjectionSession> ProjectionSessionPtr_t;
+
+      /// Projection sessions opened by the clients.
+      ///
+      /// A session belongs to the problem it was opened in. It can only be
+      /// used while this problem is selected and until the problem is
+      /// reset.
+      class ProjectionSessions
+      {
+        public:
+          ProjectionSessions ();
+
+          std::size_t open (const std::string& problemName,
+              const ProjectionSessionPtr_t& session);
+
+          /// \throw std::out_of_range if the problem has no session with
+          ///        this id.
+          ProjectionSessionPtr_t get (const std::string& problemName,
+              std::size_t id) const;
+
+          /// \throw std::out_of_range if the problem has no session with
+          ///        this id.
+          void close (const std::string& problemName, std::size_t id);
+
+          /// Close the sessions of a problem.
+          void drop (const std::string& problemName);
+
+        private:
+          typedef std::map <std::size_t,
+                  std::pair <std::string, ProjectionSessionPtr_t> > Sessions_t;
+
+          mutable boost::mutex mutex_;
+          Sessions_t sessions_;
+          std::size_t nextId_;
+      }; // class ProjectionSessions
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_PROJECTION_SESSIONS_HH
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "hpp/corbaserver/manipulation/roadmap-file.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      namespace bi = boost::interprocess;
+
+      namespace {
+        /// Whether count elements of size bytes at offset lie in the file.
+        bool inFile (boost::uint64_t offset, boost::uint64_t count,
+            std::size_t size, boost::uint64_t fileSize)
+        {
+          if (offset % 8 != 0 || offset > fileSize) return false;
+          return count <= (fileSize - offset) / size;
+        }
+      }
+
+      struct RoadmapFile::Mapping {
+        bi::file_mapping file;
+        bi::mapped_region region;
+
+        Mapping (const std::string& filename) :
+          file (filename.c_str (), bi::read_only),
+          region (file, bi::read_only)
+        {}
+      };
+
+      RoadmapFile::RoadmapFile (const std::string& filename)
+      {
+        try {
+          mapping_.reset (new Mapping (filename));
+        } catch (const bi::interprocess_exception& e) {
+          throw std::runtime_error ("Cannot map roadmap file " + filename
+              + ": " + e.what ());
+        }
+        const std::size_t size = mapping_->region.get_size ();
+        data_ = static_cast <const char*> (mapping_->region.get_address ());
+        header_ = reinterpret_cast <const RoadmapFileHeader*> (data_);
+        if (size < sizeof (RoadmapFileHeader)
+            || std::memcmp (header_->magic, "HPPRMAP", 8) != 0
+            || header_->version != ROADMAP_FILE_VERSION
+            || header_->size != size)
+          throw std::runtime_error (filename
+              + " is not a compatible roadmap file");
+        const RoadmapFileHeader& h = *header_;
+        if (h.configSize == 0
+            || !inFile (h.configurationsOffset, h.nbNodes,
+              h.configSize * sizeof (double), size)
+            || !inFile (h.nodesOffset, h.nbNodes, sizeof (RoadmapFileNode),
+              size)
+            || !inFile (h.edgesOffset, h.nbEdges, sizeof (RoadmapFileEdge),
+              size)
+            || !inFile (h.statesOffset, h.nbStates,
+              sizeof (RoadmapFileString), size))
+          throw std::runtime_error (filename + " is truncated");
+        configurations_ = reinterpret_cast <const double*>
+          (data_ + h.configurationsOffset);
+        nodes_ = reinterpret_cast <const RoadmapFileNode*>
+          (data_ + h.nodesOffset);
+        edges_ = reinterpret_cast <const RoadmapFileEdge*>
+          (data_ + h.edgesOffset);
+        states_ = reinterpret_cast <const RoadmapFileString*>
+          (data_ + h.statesOffset);
+
+        for (std::size_t i = 0; i < h.nbNodes; ++i)
+          if ((nodes_[i].state >= h.nbStates
+                && nodes_[i].state != ROADMAP_FILE_NO_STATE)
+              || nodes_[i].connectedComponent >= h.nbConnectedComponents)
+            throw std::runtime_error (filename + " is corrupted");
+        for (std::size_t i = 0; i < h.nbEdges; ++i)
+          if (edges_[i].from >= h.nbNodes || edges_[i].to >= h.nbNodes)
+            throw std::runtime_error (filename + " is corrupted");
+        for (std::size_t i = 0; i < h.nbStates; ++i)
+          if (states_[i].offset > size
+              || states_[i].size > size - states_[i].offset)
+            throw std::runtime_error (filename + " is corrupted");
+      }
+
+      RoadmapFile::~RoadmapFile ()
+      {}
+
+      std::string RoadmapFile::stateName (std::size_t state) const
+      {
+        if (state >= header_->nbStates)
+          throw std::out_of_range ("Wrong state index");
+        return std::string (data_ + states_[state].offset,
+            (std::size_t) states_[state].size);
+      }
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
@@ -0,0 +1,259 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "roadmap-index.hh"
+
+#include <algorithm>
+#include <limits>
+
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/distance.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/roadmap-node.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/state.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        /// Minimal number of nodes appended before the tree is rebuilt.
+        const std::size_t minPending = 32;
+
+        struct Item {
+          core::NodePtr_t node;
+          std::size_t rank;
+        };
+
+        struct VantagePoint {
+          std::size_t item;
+          /// Median of the distances to the items below this point.
+          value_type mu;
+          /// Closer than mu, farther than mu.
+          long inside, outside;
+        };
+
+        typedef std::pair <value_type, std::size_t> Candidate;
+      }
+
+      struct RoadmapIndex::Partition {
+        std::vector <Item> items;
+        std::vector <VantagePoint> tree;
+        std::vector <Item> pending;
+
+        /// Build the tree with the items and the pending items.
+        void rebuild (const core::Distance& distance)
+        {
+          items.insert (items.end (), pending.begin (), pending.end ());
+          pending.clear ();
+          tree.clear ();
+          tree.reserve (items.size ());
+          std::vector <Candidate> work (items.size ());
+          for (std::size_t i = 0; i < work.size (); ++i)
+            work[i] = Candidate (0, i);
+          build (distance, work, 0, work.size ());
+        }
+
+        long build (const core::Distance& distance,
+            std::vector <Candidate>& work, std::size_t begin, std::size_t end)
+        {
+          if (begin == end) return -1;
+          const long index = (long) tree.size ();
+          VantagePoint vp;
+          vp.item = work[begin].second;
+          vp.mu = 0;
+          vp.inside = vp.outside = -1;
+          tree.push_back (vp);
+          if (end - begin == 1) return index;
+
+          const Configuration_t& q = *items[vp.item].node->configuration ();
+          for (std::size_t i = begin + 1; i < end; ++i)
+            work[i].first = distance (q,
+                *items[work[i].second].node->configuration ());
+          const std::size_t mid = (begin + 1 + end) / 2;
+          std::nth_element (work.begin () + begin + 1, work.begin () + mid,
+              work.begin () + end);
+          tree[index].mu = work[mid].first;
+          const long inside = build (distance, work, begin + 1, mid);
+          const long outside = build (distance, work, mid, end);
+          tree[index].inside = inside;
+          tree[index].outside = outside;
+          return index;
+        }
+      };
+
+      struct RoadmapIndex::Entry {
+        core::RoadmapPtr_t roadmap;
+        graph::GraphPtr_t graph;
+        core::DistancePtr_t distance;
+        /// Number of nodes of the roadmap indexed.
+        std::size_t nbNodes;
+        /// Configuration of the first node indexed. Holding it keeps its
+        /// address from being reused by a node added after a clear.
+        ConfigurationPtr_t first;
+        core::Nodes_t::const_iterator last;
+        std::map <graph::StatePtr_t, Partition> partitions;
+      };
+
+      namespace {
+        typedef std::map <graph::StatePtr_t, RoadmapIndex::Partition>
+          Partitions_t;
+
+        /// Search of the nodes closer than a bound, keeping the k closest.
+        struct Search {
+          const core::Distance& distance;
+          ConfigurationIn_t q;
+          const core::ConnectedComponentPtr_t& cc;
+          const std::size_t k;
+          const value_type radius;
+          /// Current bound.
+          value_type tau;
+          /// Max-heap of the nodes found.
+          RoadmapIndex::Neighbours_t found;
+
+          Search (const core::Distance& d, ConfigurationIn_t config,
+              const core::ConnectedComponentPtr_t& c, std::size_t kMax,
+              value_type r) :
+            distance (d), q (config), cc (c), k (kMax), radius (r), tau (r)
+          {}
+
+          void consider (const Item& item, value_type d)
+          {
+            if (d > tau) return;
+            if (cc && item.node->connectedComponent () != cc) return;
+            RoadmapIndex::Neighbour n;
+            n.node = item.node;
+            n.rank = item.rank;
+            n.distance = d;
+            found.push_back (n);
+            std::push_heap (found.begin (), found.end ());
+            if (found.size () > k) {
+              std::pop_heap (found.begin (), found.end ());
+              found.pop_back ();
+            }
+            if (found.size () == k)
+              tau = std::min (radius, found.front ().distance);
+          }
+
+          void visit (const RoadmapIndex::Partition& p, long index)
+          {
+            if (index < 0) return;
+            const VantagePoint& vp = p.tree [index];
+            const Item& item = p.items [vp.item];
+            const value_type d = distance (q, *item.node->configuration ());
+            consider (item, d);
+            if (d < vp.mu) {
+              if (d - tau <= vp.mu) visit (p, vp.inside);
+              if (d + tau >= vp.mu) visit (p, vp.outside);
+            } else {
+              if (d + tau >= vp.mu) visit (p, vp.outside);
+              if (d - tau <= vp.mu) visit (p, vp.inside);
+            }
+          }
+
+          void visit (RoadmapIndex::Partition& p)
+          {
+            if (p.pending.size () > minPending + p.items.size () / 8)
+              p.rebuild (distance);
+            if (!p.tree.empty ()) visit (p, 0);
+            for (std::size_t i = 0; i < p.pending.size (); ++i)
+              consider (p.pending[i],
+                  distance (q, *p.pending[i].node->configuration ()));
+          }
+        };
+      }
+
+      RoadmapIndex::Neighbours_t RoadmapIndex::nearest
+      (const ProblemSolverPtr_t& problemSolver, const std::string& problemName,
+       const graph::StatePtr_t& state, const core::ConnectedComponentPtr_t& cc,
+       ConfigurationIn_t q, std::size_t k)
+      {
+        if (k == 0) return Neighbours_t ();
+        return search (problemSolver, problemName, state, cc, q, k,
+            std::numeric_limits <value_type>::infinity ());
+      }
+
+      RoadmapIndex::Neighbours_t RoadmapIndex::withinRadius
+      (const ProblemSolverPtr_t& problemSolver, const std::string& problemName,
+       const graph::StatePtr_t& state, const core::ConnectedComponentPtr_t& cc,
+       ConfigurationIn_t q, value_type radius)
+      {
+        return search (problemSolver, problemName, state, cc, q,
+            std::numeric_limits <std::size_t>::max (), radius);
+      }
+
+      RoadmapIndex::Entry& RoadmapIndex::update
+      (const ProblemSolverPtr_t& problemSolver, const std::string& problemName)
+      {
+        boost::shared_ptr <Entry>& e = entries_ [problemName];
+        const core::RoadmapPtr_t& roadmap = problemSolver->roadmap ();
+        const graph::GraphPtr_t& graph = problemSolver->constraintGraph ();
+        const core::Nodes_t& nodes = roadmap->nodes ();
+        if (!e || e->roadmap != roadmap || e->graph != graph
+            || nodes.size () < e->nbNodes
+            || (e->nbNodes > 0
+              && nodes.front ()->configuration () != e->first)) {
+          e.reset (new Entry);
+          e->roadmap = roadmap;
+          e->graph = graph;
+          e->distance = roadmap->distance ();
+          e->nbNodes = 0;
+        }
+
+        core::Nodes_t::const_iterator it = nodes.begin ();
+        if (e->nbNodes > 0) {
+          it = e->last;
+          ++it;
+        }
+        for (; it != nodes.end (); ++it) {
+          graph::StatePtr_t state;
+          if (RoadmapNodePtr_t node = dynamic_cast <RoadmapNodePtr_t> (*it))
+            state = node->graphState ();
+          Item item;
+          item.node = *it;
+          item.rank = e->nbNodes;
+          e->partitions [state].pending.push_back (item);
+          if (e->nbNodes == 0) e->first = (*it)->configuration ();
+          e->last = it;
+          ++e->nbNodes;
+        }
+        return *e;
+      }
+
+      RoadmapIndex::Neighbours_t RoadmapIndex::search
+      (const ProblemSolverPtr_t& problemSolver, const std::string& problemName,
+       const graph::StatePtr_t& state, const core::ConnectedComponentPtr_t& cc,
+       ConfigurationIn_t q, std::size_t k, value_type radius)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Entry& e = update (problemSolver, problemName);
+        Search s (*e.distance, q, cc, k, radius);
+        if (state) {
+          Partitions_t::iterator p = e.partitions.find (state);
+          if (p != e.partitions.end ()) s.visit (p->second);
+        } else {
+          for (Partitions_t::iterator p = e.partitions.begin ();
+              p != e.partitions.end (); ++p)
+            s.visit (p->second);
+        }
+        std::sort_heap (s.found.begin (), s.found.end ());
+        return s.found;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_ROADMAP_INDEX_HH
+# define HPP_MANIPULATION_CORBA_ROADMAP_INDEX_HH
+
+# include <map>
+# include <string>
+# include <vector>
+
+# include <boost/thread/mutex.hpp>
+
+# include <hpp/core/fwd.hh>
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Nearest neighbours of the roadmap nodes, by state of the
+      /// constraint graph.
+      ///
+      /// The nodes of each state are stored in a vantage-point tree over
+      /// the distance of the roadmap, which only relies on the triangle
+      /// inequality. The nodes added to the roadmap since the last query
+      /// are appended to a list scanned linearly, and the tree is rebuilt
+      /// when this list gets long compared to the tree.
+      ///
+      /// Connected components merge when edges are added, so they are not
+      /// part of the partition: queries restricted to a connected component
+      /// filter the nodes of the state.
+      ///
+      /// The nodes are sorted by the state cached in them when they were
+      /// added to the roadmap, so that no constraint is evaluated. Nodes
+      /// without a cached state are only found by queries on any state.
+      ///
+      /// One index is kept per problem. The roadmap is only read, when
+      /// queried: nodes are never removed from a roadmap, and a roadmap
+      /// that was cleared or replaced is indexed again.
+      class RoadmapIndex
+      {
+        public:
+          struct Neighbour {
+            core::NodePtr_t node;
+            /// Rank of the node in core::Roadmap::nodes.
+            std::size_t rank;
+            value_type distance;
+
+            bool operator< (const Neighbour& other) const
+            {
+              return distance < other.distance;
+            }
+          };
+          typedef std::vector <Neighbour> Neighbours_t;
+
+          /// The k nearest nodes, sorted by increasing distance.
+          /// \param state nodes of this state, any state if NULL.
+          /// \param cc nodes of this connected component, any if NULL.
+          Neighbours_t nearest (const ProblemSolverPtr_t& problemSolver,
+              const std::string& problemName, const graph::StatePtr_t& state,
+              const core::ConnectedComponentPtr_t& cc, ConfigurationIn_t q,
+              std::size_t k);
+
+          /// The nodes closer than radius, sorted by increasing distance.
+          Neighbours_t withinRadius (const ProblemSolverPtr_t& problemSolver,
+              const std::string& problemName, const graph::StatePtr_t& state,
+              const core::ConnectedComponentPtr_t& cc, ConfigurationIn_t q,
+              value_type radius);
+
+          struct Partition;
+          struct Entry;
+
+        private:
+          /// Add the new nodes of the roadmap to the entry of a problem.
+          Entry& update (const ProblemSolverPtr_t& problemSolver,
+              const std::string& problemName);
+
+          Neighbours_t search (const ProblemSolverPtr_t& problemSolver,
+              const std::string& problemName, const graph::StatePtr_t& state,
+              const core::ConnectedComponentPtr_t& cc, ConfigurationIn_t q,
+              std::size_t k, value_type radius);
+
+          boost::mutex mutex_;
+          std::map <std::string, boost::shared_ptr <Entry> > entries_;
+      }; // class RoadmapIndex
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_ROADMAP_INDEX_HH
@@ -0,0 +1,297 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "roadmap-io.hh"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+#include <hpp/util/debug.hh>
+#include <hpp/core/connected-component.hh>
+#include <hpp/core/edge.hh>
+#include <hpp/core/node.hh>
+#include <hpp/core/path.hh>
+#include <hpp/core/path-projector.hh>
+#include <hpp/core/path-validation.hh>
+#include <hpp/core/path-validation-report.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/steering-method.hh>
+#include <hpp/manipulation/device.hh>
+#include <hpp/manipulation/problem.hh>
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/roadmap-node.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/state.hh>
+#include <hpp/manipulation/steering-method/graph.hh>
+
+#include <hpp/corbaserver/manipulation/roadmap-file.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        using corbaServer::manipulation::RoadmapFile;
+        using corbaServer::manipulation::RoadmapFileHeader;
+        using corbaServer::manipulation::RoadmapFileNode;
+        using corbaServer::manipulation::RoadmapFileEdge;
+        using corbaServer::manipulation::RoadmapFileString;
+        using corbaServer::manipulation::ROADMAP_FILE_VERSION;
+        using corbaServer::manipulation::ROADMAP_FILE_NO_STATE;
+
+        typedef boost::uint64_t uint64;
+        typedef boost::uint32_t uint32;
+
+        uint64 aligned (uint64 offset)
+        {
+          return (offset + 7) & ~(uint64) 7;
+        }
+
+        void pad (std::ostream& os, uint64 offset)
+        {
+          static const char zeros [8] = { 0 };
+          os.write (zeros, aligned (offset) - offset);
+        }
+
+        template <typename T> void write (std::ostream& os, const T& t)
+        {
+          os.write (reinterpret_cast <const char*> (&t), sizeof (T));
+        }
+
+        /// Index of the state names, in the order they are met.
+        struct StateNames
+        {
+          std::map <std::string, uint32> indices;
+          std::vector <std::string> names;
+
+          uint32 index (const std::string& name)
+          {
+            std::map <std::string, uint32>::const_iterator it =
+              indices.find (name);
+            if (it != indices.end ()) return it->second;
+            uint32 i = (uint32) names.size ();
+            indices [name] = i;
+            names.push_back (name);
+            return i;
+          }
+        };
+      }
+
+      void RoadmapIO::save (const ProblemSolverPtr_t& problemSolver,
+          const std::string& filename)
+      {
+        const core::RoadmapPtr_t& roadmap = problemSolver->roadmap ();
+        const core::Nodes_t& nodes = roadmap->nodes ();
+        const core::Edges_t& edges = roadmap->edges ();
+        const core::ConnectedComponents_t& ccs =
+          roadmap->connectedComponents ();
+        const std::size_t nq = problemSolver->robot ()->configSize ();
+
+        std::map <const core::ConnectedComponent*, uint32> ccIndices;
+        for (core::ConnectedComponents_t::const_iterator it = ccs.begin ();
+            it != ccs.end (); ++it)
+          ccIndices.insert (std::make_pair (it->get (),
+                (uint32) ccIndices.size ()));
+
+        std::map <const core::Node*, uint32> nodeIndices;
+        std::vector <RoadmapFileNode> fileNodes;
+        fileNodes.reserve (nodes.size ());
+        StateNames states;
+        for (core::Nodes_t::const_iterator it = nodes.begin ();
+            it != nodes.end (); ++it) {
+          nodeIndices.insert (std::make_pair (*it,
+                (uint32) nodeIndices.size ()));
+          // The state cached in the node, so that no constraint is
+          // evaluated and nodes in no state are saved without one.
+          RoadmapNodePtr_t node = dynamic_cast <RoadmapNodePtr_t> (*it);
+          RoadmapFileNode n;
+          n.state = (node && node->graphState ()
+              ? states.index (node->graphState ()->name ())
+              : (uint32) ROADMAP_FILE_NO_STATE);
+          n.connectedComponent =
+            ccIndices [(*it)->connectedComponent ().get ()];
+          fileNodes.push_back (n);
+        }
+
+        std::vector <RoadmapFileEdge> fileEdges;
+        fileEdges.reserve (edges.size ());
+        for (core::Edges_t::const_iterator it = edges.begin ();
+            it != edges.end (); ++it) {
+          RoadmapFileEdge e;
+          e.from = nodeIndices [(*it)->from ()];
+          e.to = nodeIndices [(*it)->to ()];
+          e.length = (*it)->path ()->length ();
+          fileEdges.push_back (e);
+        }
+
+        RoadmapFileHeader h;
+        std::memset (&h, 0, sizeof (h));
+        std::memcpy (h.magic, "HPPRMAP", 8);
+        h.version = ROADMAP_FILE_VERSION;
+        h.configSize = (uint32) nq;
+        h.nbNodes = fileNodes.size ();
+        h.nbEdges = fileEdges.size ();
+        h.nbStates = states.names.size ();
+        h.nbConnectedComponents = ccIndices.size ();
+        h.configurationsOffset = aligned (sizeof (h));
+        h.nodesOffset = aligned (h.configurationsOffset
+            + h.nbNodes * nq * sizeof (double));
+        h.edgesOffset = aligned (h.nodesOffset
+            + h.nbNodes * sizeof (RoadmapFileNode));
+        h.statesOffset = aligned (h.edgesOffset
+            + h.nbEdges * sizeof (RoadmapFileEdge));
+        // The names follow the table of states.
+        uint64 offset = h.statesOffset + h.nbStates * sizeof (RoadmapFileString);
+        std::vector <RoadmapFileString> fileStates (h.nbStates);
+        for (std::size_t i = 0; i < fileStates.size (); ++i) {
+          fileStates[i].offset = offset;
+          fileStates[i].size = states.names[i].size ();
+          offset += fileStates[i].size;
+        }
+        h.size = offset;
+
+        std::ostringstream tmp;
+        tmp << filename << "." << ::getpid () << ".tmp";
+        {
+          std::ofstream os (tmp.str ().c_str (), std::ios::binary);
+          if (!os)
+            throw std::runtime_error ("Cannot write roadmap file " + filename);
+          write (os, h);
+          pad (os, sizeof (h));
+          for (core::Nodes_t::const_iterator it = nodes.begin ();
+              it != nodes.end (); ++it) {
+            const Configuration_t& q = *(*it)->configuration ();
+            os.write (reinterpret_cast <const char*> (q.data ()),
+                nq * sizeof (double));
+          }
+          pad (os, h.configurationsOffset + h.nbNodes * nq * sizeof (double));
+          if (!fileNodes.empty ())
+            os.write (reinterpret_cast <const char*> (&fileNodes[0]),
+                fileNodes.size () * sizeof (RoadmapFileNode));
+          pad (os, h.nodesOffset + h.nbNodes * sizeof (RoadmapFileNode));
+          if (!fileEdges.empty ())
+            os.write (reinterpret_cast <const char*> (&fileEdges[0]),
+                fileEdges.size () * sizeof (RoadmapFileEdge));
+          pad (os, h.edgesOffset + h.nbEdges * sizeof (RoadmapFileEdge));
+          if (!fileStates.empty ())
+            os.write (reinterpret_cast <const char*> (&fileStates[0]),
+                fileStates.size () * sizeof (RoadmapFileString));
+          for (std::size_t i = 0; i < states.names.size (); ++i)
+            os.write (states.names[i].data (), states.names[i].size ());
+          if (!os) {
+            os.close ();
+            std::remove (tmp.str ().c_str ());
+            throw std::runtime_error ("Cannot write roadmap file " + filename);
+          }
+        }
+        if (std::rename (tmp.str ().c_str (), filename.c_str ()) != 0) {
+          std::remove (tmp.str ().c_str ());
+          throw std::runtime_error ("Cannot write roadmap file " + filename);
+        }
+        hppDout (info, "Saved " << h.nbNodes << " nodes and " << h.nbEdges
+            << " edges in " << filename);
+      }
+
+      std::size_t RoadmapIO::load (const ProblemSolverPtr_t& problemSolver,
+          const std::string& filename, std::size_t& nbEdges,
+          std::size_t& nbSkipped)
+      {
+        RoadmapFile file (filename);
+        const RoadmapFileHeader& h = file.header ();
+        const std::size_t nq = problemSolver->robot ()->configSize ();
+        if (h.configSize != nq) {
+          std::ostringstream oss;
+          oss << filename << ": configurations of size " << h.configSize
+            << ", expected " << nq;
+          throw std::runtime_error (oss.str ());
+        }
+
+        // Check all the nodes before modifying the roadmap.
+        const graph::GraphPtr_t& graph = problemSolver->constraintGraph ();
+        std::vector <ConfigurationPtr_t> configs (h.nbNodes);
+        for (std::size_t i = 0; i < configs.size (); ++i) {
+          configs[i].reset (new Configuration_t (Eigen::Map
+                <const Configuration_t> (file.configuration (i), nq)));
+          const uint32 state = file.node (i).state;
+          if (state == ROADMAP_FILE_NO_STATE || !graph) continue;
+          std::string name;
+          try {
+            name = graph->getState (*configs[i])->name ();
+          } catch (const std::exception& exc) {
+            std::ostringstream oss;
+            oss << filename << ": node " << i << " was saved in state "
+              << file.stateName (state) << " and is in no state: "
+              << exc.what ();
+            throw std::runtime_error (oss.str ());
+          }
+          if (name != file.stateName (state)) {
+            std::ostringstream oss;
+            oss << filename << ": node " << i << " was saved in state "
+              << file.stateName (state) << " and is in state " << name;
+            throw std::runtime_error (oss.str ());
+          }
+        }
+
+        const ProblemPtr_t& problem = problemSolver->problem ();
+        if (!problem->steeringMethod ()
+            || !problem->steeringMethod ()->innerSteeringMethod ())
+          problemSolver->initSteeringMethod ();
+        const core::SteeringMethodPtr_t sm = problem->steeringMethod ();
+        const core::PathProjectorPtr_t projector = problem->pathProjector ();
+        const core::PathValidationPtr_t validation = problem->pathValidation ();
+
+        const core::RoadmapPtr_t& roadmap = problemSolver->roadmap ();
+        std::vector <core::NodePtr_t> nodes (h.nbNodes);
+        for (std::size_t i = 0; i < nodes.size (); ++i)
+          nodes[i] = roadmap->addNode (configs[i]);
+
+        nbEdges = nbSkipped = 0;
+        for (std::size_t i = 0; i < h.nbEdges; ++i) {
+          const RoadmapFileEdge& e = file.edge (i);
+          core::PathPtr_t path = (*sm) (*configs[e.from], *configs[e.to]);
+          if (path && projector) {
+            core::PathPtr_t projected;
+            if (!projector->apply (path, projected)) path.reset ();
+            else path = projected;
+          }
+          if (path && validation) {
+            core::PathPtr_t validPart;
+            core::PathValidationReportPtr_t report;
+            if (!validation->validate (path, false, validPart, report))
+              path.reset ();
+          }
+          if (!path) {
+            hppDout (info, "Skipping edge " << i << " of " << filename);
+            ++nbSkipped;
+            continue;
+          }
+          roadmap->addEdge (nodes[e.from], nodes[e.to], path);
+          ++nbEdges;
+        }
+        hppDout (info, "Loaded " << nodes.size () << " nodes and " << nbEdges
+            << " edges from " << filename << ", skipped " << nbSkipped
+            << " edges");
+        return nodes.size ();
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
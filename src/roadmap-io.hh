@@ -0,0 +1,59 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_ROADMAP_IO_HH
+# define HPP_MANIPULATION_CORBA_ROADMAP_IO_HH
+
+# include <string>
+
+# include <hpp/manipulation/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Save and load the roadmap of a problem solver in the format of
+      /// hpp::corbaServer::manipulation::RoadmapFile.
+      struct RoadmapIO
+      {
+        /// Write the roadmap of the problem solver.
+        ///
+        /// The file is written under a temporary name and renamed, so that
+        /// readers never map a partial file.
+        /// \throw std::runtime_error if the file cannot be written.
+        static void save (const ProblemSolverPtr_t& problemSolver,
+            const std::string& filename);
+
+        /// Add the nodes and edges of a file to the roadmap of the problem
+        /// solver.
+        ///
+        /// The paths of the edges are computed again by the steering method
+        /// of the problem, projected by its path projector, if any, and
+        /// checked by its path validation. The edges for which one of them
+        /// fails are skipped.
+        /// \param[out] nbEdges number of edges added,
+        /// \param[out] nbSkipped number of edges skipped.
+        /// \return the number of nodes added.
+        /// \throw std::runtime_error if the configuration size differs or
+        ///        if a node is not in the state it was saved in.
+        static std::size_t load (const ProblemSolverPtr_t& problemSolver,
+            const std::string& filename, std::size_t& nbEdges,
+            std::size_t& nbSkipped);
+      }; // struct RoadmapIO
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_ROADMAP_IO_HH
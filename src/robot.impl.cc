@@ -17,8 +17,12 @@
 
 #include "robot.impl.hh"
 
+#include <set>
+
 #include <pinocchio/multibody/model.hpp>
 
+#include <hpp/fcl/BVH/BVH_model.h>
+
 #include <hpp/util/debug.hh>
 #include <hpp/util/exception-factory.hh>
 #include <hpp/pinocchio/humanoid-robot.hh>
@@ -32,14 +36,22 @@
 
 #include <hpp/corbaserver/manipulation/server.hh>
 
+#include "environment-model.hh"
+#include "metrics.hh"
+#include "model-cache.hh"
+#include "projection-sessions.hh"
+#include "scene-assemblies.hh"
+#include "scheduler.hh"
+#include "solve-jobs.hh"
 #include "tools.hh"
+#include "versions.hh"
 
 namespace hpp {
   namespace manipulation {
     namespace impl {
       namespace {
         using pinocchio::Gripper;
-        using core::Container;
+        using corbaServer::floatSeqToConfigPtr;
 
         DevicePtr_t getOrCreateRobot (ProblemSolverPtr_t p,
             const std::string& name = "Robot")
@@ -61,60 +73,254 @@ namespace hpp {
           return j;
         }
 
-        template<typename GripperOrHandle>
-          GripperOrHandle copy (const GripperOrHandle& in, const DevicePtr_t& device, const std::string& p);
-
-        template<> GripperPtr_t copy (const GripperPtr_t& in, const DevicePtr_t& device, const std::string& p) {
-            Transform3f position = (in->joint()
-                ? in->joint()->currentTransformation() * in->objectPositionInJoint()
-                : in->objectPositionInJoint());
-
-            se3::Model& model = device->model();
-            const std::string name = p + in->name();
-            if (model.existFrame(name))
-              throw std::invalid_argument ("Could not add the gripper because a frame \'" + name + "\" already exists.");
-            model.addFrame (se3::Frame(
-                  name,
-                  model.getJointId("universe"),
-                  model.getFrameId("universe"),
-                  position,
-                  se3::OP_FRAME));
-
-            GripperPtr_t out = Gripper::create(name, device);
-            out->clearance (in->clearance());
-            return out;
+        /// Joints of the links, looked up once per link.
+        std::vector <JointPtr_t> jointsOfLinks (ProblemSolverPtr_t p,
+            const Names_t& linkNames)
+        {
+          std::map <std::string, JointPtr_t> joints;
+          std::vector <JointPtr_t> result (linkNames.length ());
+          for (CORBA::ULong i = 0; i < linkNames.length (); ++i) {
+            JointPtr_t& j = joints [std::string (linkNames[i])];
+            if (!j) j = getJointByBodyNameOrThrow (p, linkNames[i]);
+            result[i] = j;
+          }
+          return result;
+        }
+
+        std::vector <Transform3f> toTransforms (const floatSeqSeq& in)
+        {
+          std::vector <Transform3f> result (in.length ());
+          for (CORBA::ULong i = 0; i < in.length (); ++i) {
+            if (in[i].length () != 7)
+              throw hpp::Error ("A position must have 7 values.");
+            hppTransformToTransform3f (in[i].get_buffer (), result[i]);
+          }
+          return result;
+        }
+
+        void checkNewNames (const Names_t& names, const std::size_t n,
+            bool (*exists) (const DevicePtr_t&, const std::string&),
+            const DevicePtr_t& robot)
+        {
+          if (names.length () != n)
+            throw hpp::Error ("The arguments must have the same length.");
+          std::set <std::string> seen;
+          for (CORBA::ULong i = 0; i < names.length (); ++i) {
+            std::string name (names[i]);
+            if (!seen.insert (name).second || exists (robot, name))
+              throw hpp::Error (("Name " + name + " is already used.")
+                  .c_str ());
+          }
         }
 
-        template<> HandlePtr_t copy (const HandlePtr_t& in, const DevicePtr_t& device, const std::string& p) {
-            Transform3f position = (in->joint()
-                ? in->joint()->currentTransformation() * in->localPosition()
-                : in->localPosition());
+        bool gripperExists (const DevicePtr_t& r, const std::string& n)
+        {
+          return r->grippers.has (n) || r->model ().existFrame (n);
+        }
 
-            HandlePtr_t out = Handle::create(p + in->name(), position, JointPtr_t(new Joint(device, 0)));
-            out->clearance (in->clearance());
-            return out;
+        bool handleExists (const DevicePtr_t& r, const std::string& n)
+        {
+          return r->handles.has (n);
         }
 
-        template<typename Object>
-        void copy(const Container<Object>& from, Container<Object>& to, const DevicePtr_t& d, const std::string& prefix)
+        /// Fill the outputs of getGripperPositions and getHandlePositions.
+        /// \tparam Accessor provides the position in joint of an element.
+        template <typename Element, typename Accessor>
+        Names_t* positions (const DevicePtr_t& robot,
+            const core::Container <Element>& elements, const floatSeq& config,
+            Names_t_out jointNames, floatSeqSeq_out positionsInJoint,
+            floatSeqSeq_out positions)
         {
-          typedef Container<Object> Container_t;
-          for (typename Container_t::const_iterator it = from.map.begin ();
-              it != from.map.end (); it++) {
-            Object obj = copy<Object>(it->second, d, prefix);
-            to.add (obj->name(), obj);
+          typedef typename core::Container <Element>::Map_t Map_t;
+          const Map_t& map = elements.map;
+          Configuration_t saved;
+          if (config.length () > 0) {
+            saved = robot->currentConfiguration ();
+            robot->currentConfiguration
+              (*floatSeqToConfigPtr (robot, config, true));
+          }
+          robot->computeForwardKinematics ();
+
+          std::vector <std::string> names, joints;
+          floatSeqSeq_var inJoint = new floatSeqSeq ();
+          floatSeqSeq_var world = new floatSeqSeq ();
+          inJoint->length ((CORBA::ULong) map.size ());
+          world->length ((CORBA::ULong) map.size ());
+          CORBA::ULong i = 0;
+          for (typename Map_t::const_iterator it = map.begin ();
+              it != map.end (); ++it, ++i) {
+            const JointPtr_t joint = it->second->joint ();
+            const Transform3f local = Accessor::get (*it->second);
+            names.push_back (it->first);
+            joints.push_back (joint ? joint->name () : "universe");
+            inJoint [i].length (7);
+            Transform3fTohppTransform (local, inJoint [i].get_buffer ());
+            world [i].length (7);
+            Transform3fTohppTransform (joint
+                ? joint->currentTransformation () * local : local,
+                world [i].get_buffer ());
+          }
+
+          if (config.length () > 0) {
+            robot->currentConfiguration (saved);
+            robot->computeForwardKinematics ();
           }
+          jointNames = toNames_t (joints.begin (), joints.end ());
+          positionsInJoint = inJoint._retn ();
+          positions = world._retn ();
+          return toNames_t (names.begin (), names.end ());
         }
+
+        /// Number of triangles of the meshes of the objects of a device
+        /// whose name starts with prefix.
+        std::size_t meshTriangles (const DevicePtr_t& device,
+            const std::string& prefix)
+        {
+          typedef fcl::BVHModel <fcl::OBBRSS> Mesh_t;
+          using pinocchio::DeviceObjectVector;
+          std::size_t n = 0;
+          DeviceObjectVector& objects = device->objectVector ();
+          for (DeviceObjectVector::iterator it = objects.begin ();
+              it != objects.end (); ++it) {
+            if ((*it)->name ().compare (0, prefix.size (), prefix) != 0)
+              continue;
+            const Mesh_t* mesh = dynamic_cast <const Mesh_t*>
+              ((*it)->fcl ()->collisionGeometry ().get ());
+            if (mesh == NULL) continue;
+            hppDout (info, "Mesh " << (*it)->name () << ": "
+                << mesh->num_tris << " triangles");
+            n += (std::size_t) mesh->num_tris;
+          }
+          return n;
+        }
+
+        struct GripperPosition {
+          static Transform3f get (const pinocchio::Gripper& g)
+          {
+            return g.objectPositionInJoint ();
+          }
+        };
+
+        struct HandlePosition {
+          static Transform3f get (const Handle& h)
+          {
+            return h.localPosition ();
+          }
+        };
       }
 
       Robot::Robot () : server_ (0x0)
       {}
 
+      CORBA::Boolean Robot::_dispatch (omniCallHandle& handle)
+      {
+        server_->solveJobs ().checkIdle (dynamic_cast <ProblemSolverPtr_t>
+            (server_->problemSolverMap ()->selected ()), "Robot",
+            handle.operation_name ());
+        server_->sceneAssemblies ().checkAllowed
+          (server_->problemSolverMap ()->selected_, "Robot",
+           handle.operation_name ());
+        // Time spent waiting for admission is not part of the metrics of
+        // the operation.
+        impl::Scheduler::Ticket ticket (server_->scheduler (), "Robot",
+            handle.operation_name ());
+        impl::ServerMetrics::Call call (server_->metrics (), "Robot",
+            handle.operation_name ());
+        // Destroyed before call, so that the metrics include the update.
+        impl::Versions::Update update (*server_, "Robot",
+            handle.operation_name ());
+        try {
+          CORBA::Boolean found =
+            POA_hpp::corbaserver::manipulation::Robot::_dispatch (handle);
+          if (!found) {
+            call.discard ();
+            update.discard ();
+          }
+          return found;
+        } catch (...) {
+          call.failed ();
+          throw;
+        }
+      }
+
       ProblemSolverPtr_t Robot::problemSolver ()
       {
         return server_->problemSolver();
       }
 
+      void Robot::resetProblem ()
+      {
+        if (server_->sceneAssemblies ().inserted
+            (server_->problemSolverMap ()->selected_))
+          return;
+        server_->projectionSessions ().drop
+          (server_->problemSolverMap ()->selected_);
+        problemSolver()->resetProblem ();
+      }
+
+      void Robot::loadModel (const DevicePtr_t& robot,
+          const std::string& name, const std::string& rootJointType,
+          const std::string& package, const std::string& modelName,
+          const std::string& urdfSuffix, const std::string& srdfSuffix,
+          ModelCache::LoadTimes_t& imported)
+      {
+        ModelCache& cache = server_->modelCache ();
+        std::string urdf, srdf;
+        if (cache.enabled ()
+            && ModelCache::read ("package://" + package + "/urdf/"
+              + modelName + urdfSuffix + ".urdf", urdf)
+            && ModelCache::read ("package://" + package + "/srdf/"
+              + modelName + srdfSuffix + ".srdf", srdf)
+            && cache.cacheMeshes (urdf, &imported)) {
+          pinocchio::urdf::loadModelFromString (robot, 0, name,
+              rootJointType, urdf, srdf);
+        } else {
+          imported.clear ();
+          pinocchio::urdf::loadRobotModel (robot, 0, name, rootJointType,
+              package, modelName, urdfSuffix, srdfSuffix);
+        }
+      }
+
+      void Robot::loadModelFromString (const DevicePtr_t& robot,
+          const std::string& name, const std::string& rootJointType,
+          std::string urdf, const std::string& srdf,
+          ModelCache::LoadTimes_t& imported)
+      {
+        server_->modelCache ().cacheMeshes (urdf, &imported);
+        pinocchio::urdf::loadModelFromString (robot, 0, name, rootJointType,
+            urdf, srdf);
+      }
+
+      void Robot::loaded (const std::string& name,
+          ServerMetrics::value_type start, std::size_t triangles,
+          const ModelCache::LoadTimes_t& imported)
+      {
+        ModelCache::LoadTimes_t times (imported);
+        for (std::size_t i = 0; i < imported.size (); ++i)
+          hppDout (info, "Imported " << imported[i].name << " ("
+              << imported[i].triangles << " triangles) in "
+              << imported[i].seconds << " s");
+        ModelCache::LoadTime t;
+        t.name = name;
+        t.triangles = triangles;
+        t.seconds = 1e-9 * (double) (ServerMetrics::now () - start);
+        hppDout (info, "Loaded " << name << " (" << triangles
+            << " triangles) in " << t.seconds << " s");
+        times.push_back (t);
+        boost::mutex::scoped_lock lock (loadTimesMutex_);
+        loadTimes_ = times;
+      }
+
+      void Robot::loaded (const ModelCache::LoadTimes_t& times)
+      {
+        for (std::size_t i = 0; i < times.size (); ++i)
+          hppDout (info, "Built BVH of " << times[i].name << " ("
+              << times[i].triangles << " triangles) in "
+              << times[i].seconds << " s");
+        boost::mutex::scoped_lock lock (loadTimesMutex_);
+        loadTimes_ = times;
+      }
+
       void Robot::finishedRobot (const char* name)
 	throw (Error)
       {
@@ -132,15 +338,20 @@ namespace hpp {
 	throw (Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getOrCreateRobot (problemSolver());
           if (robot->frameIndices.has (robotName))
             HPP_THROW(std::invalid_argument, "A robot named " << robotName << " already exists");
-          pinocchio::urdf::loadRobotModel (robot, 0, robotName, rootJointType,
-              packageName, modelName, urdfSuffix, srdfSuffix);
+          ModelCache::LoadTimes_t imported;
+          loadModel (robot, robotName, rootJointType, packageName, modelName,
+              urdfSuffix, srdfSuffix, imported);
 	  srdf::loadModelFromFile (robot, robotName,
               packageName, modelName, srdfSuffix);
+          loaded (robotName, start,
+              meshTriangles (robot, std::string (robotName) + "/"),
+              imported);
           robot->didInsertRobot (robotName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -153,15 +364,20 @@ namespace hpp {
 	throw (Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getOrCreateRobot (problemSolver());
           if (robot->frameIndices.has (robotName))
             HPP_THROW(std::invalid_argument, "A robot named " << robotName << " already exists");
 
-          pinocchio::urdf::loadModelFromString (robot, 0, robotName,
-              rootJointType, urdfString, srdfString);
+          ModelCache::LoadTimes_t imported;
+          loadModelFromString (robot, robotName, rootJointType, urdfString,
+              srdfString, imported);
 	  srdf::loadModelFromXML (robot, robotName, srdfString);
+          loaded (robotName, start,
+              meshTriangles (robot, std::string (robotName) + "/"),
+              imported);
           robot->didInsertRobot (robotName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -178,7 +394,7 @@ namespace hpp {
               std::string (packageName), std::string (modelName),
               std::string (srdfSuffix));
           robot->didInsertRobot (robotName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -191,15 +407,20 @@ namespace hpp {
 	throw (Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getOrCreateRobot (problemSolver());
           if (robot->frameIndices.has (objectName))
             HPP_THROW(std::invalid_argument, "A robot named " << objectName << " already exists");
-          pinocchio::urdf::loadRobotModel (robot, 0, objectName, rootJointType,
-              packageName, modelName, urdfSuffix, srdfSuffix);
+          ModelCache::LoadTimes_t imported;
+          loadModel (robot, objectName, rootJointType, packageName, modelName,
+              urdfSuffix, srdfSuffix, imported);
           srdf::loadModelFromFile (robot, objectName,
               packageName, modelName, srdfSuffix);
+          loaded (objectName, start,
+              meshTriangles (robot, std::string (objectName) + "/"),
+              imported);
           robot->didInsertRobot (objectName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -212,16 +433,21 @@ namespace hpp {
 	throw (Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getOrCreateRobot (problemSolver());
           if (robot->frameIndices.has (robotName))
             HPP_THROW(std::invalid_argument, "A robot named " << robotName << " already exists");
-          pinocchio::urdf::loadRobotModel (robot, 0, robotName, rootJointType,
-              packageName, modelName, urdfSuffix, srdfSuffix);
+          ModelCache::LoadTimes_t imported;
+          loadModel (robot, robotName, rootJointType, packageName, modelName,
+              urdfSuffix, srdfSuffix, imported);
           pinocchio::urdf::setupHumanoidRobot (robot, robotName);
           srdf::loadModelFromFile (robot, robotName,
               packageName, modelName, srdfSuffix);
+          loaded (robotName, start,
+              meshTriangles (robot, std::string (robotName) + "/"),
+              imported);
           robot->didInsertRobot (robotName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -234,15 +460,20 @@ namespace hpp {
 	throw (Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getOrCreateRobot (problemSolver());
           if (robot->frameIndices.has (robotName))
             HPP_THROW(std::invalid_argument, "A robot named " << robotName << " already exists");
-          pinocchio::urdf::loadModelFromString (robot, 0, robotName,
-              rootJointType, urdfString, srdfString);
+          ModelCache::LoadTimes_t imported;
+          loadModelFromString (robot, robotName, rootJointType, urdfString,
+              srdfString, imported);
           pinocchio::urdf::setupHumanoidRobot (robot, robotName);
 	  srdf::loadModelFromXML (robot, robotName, srdfString);
+          loaded (robotName, start,
+              meshTriangles (robot, std::string (robotName) + "/"),
+              imported);
           robot->didInsertRobot (robotName);
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw Error (exc.what ());
 	}
@@ -254,50 +485,43 @@ namespace hpp {
 	throw (hpp::Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getRobotOrThrow (problemSolver());
 
           std::string modelName (envModelName); 
-          DevicePtr_t object = Device::create (modelName);
-          pinocchio::urdf::loadUrdfModel (object, "anchor",
-              package, modelName + std::string(urdfSuffix));
-          srdf::loadModelFromFile (object, "",
-              package, envModelName, srdfSuffix);
           std::string p (prefix);
-          object->controlComputation(Device::JOINT_POSITION);
-          object->computeForwardKinematics();
-          object->updateGeometryPlacements();
-
-	  // Detach objects from joints
-          using pinocchio::DeviceObjectVector;
-          DeviceObjectVector& objects = object->objectVector();
-          for (DeviceObjectVector::iterator itObj = objects.begin();
-              itObj != objects.end(); ++itObj) {
-            problemSolver()->addObstacle (
-                p + (*itObj)->name (),
-                *(*itObj)->fcl (),
-                true, true);
-	    hppDout (info, "Adding obstacle " << obj->name ());
-	  }
-          typedef core::Container<JointAndShapes_t>::Map_t ShapeMap;
-          const ShapeMap& m = object->jointAndShapes.map;
-          for (ShapeMap::const_iterator it = m.begin ();
-              it != m.end (); it++) {
-            JointAndShapes_t shapes;
-            for (JointAndShapes_t::const_iterator itT = it->second.begin ();
-                itT != it->second.end(); ++itT) {
-              const Transform3f& M = itT->first->currentTransformation ();
-              Shape_t newShape (itT->second.size());
-              for (std::size_t i = 0; i < newShape.size (); ++i)
-                newShape [i] = M.act (itT->second[i]);
-              shapes.push_back (JointAndShape_t (JointPtr_t(), newShape));
+          ModelCache& cache = server_->modelCache ();
+          std::string urdf, srdf, key;
+          bool cached = cache.enabled ()
+            && ModelCache::read ("package://" + std::string (package)
+                + "/urdf/" + modelName + urdfSuffix + ".urdf", urdf)
+            && ModelCache::read ("package://" + std::string (package)
+                + "/srdf/" + modelName + srdfSuffix + ".srdf", srdf);
+          if (cached) key = cache.key (urdf, srdf, "anchor");
+
+          EnvironmentModel env;
+          ModelCache::LoadTimes_t times;
+          if (cached && cache.load (key, env, &times)) {
+            loaded (times);
+          } else {
+            DevicePtr_t object = Device::create (modelName);
+            if (cached && cache.cacheMeshes (urdf, &times)) {
+              pinocchio::urdf::loadModelFromString (object, 0, "",
+                  "anchor", urdf, srdf);
+            } else {
+              pinocchio::urdf::loadUrdfModel (object, "anchor",
+                  package, modelName + std::string(urdfSuffix));
             }
-            problemSolver()->jointAndShapes.add (p + it->first, shapes);
+            srdf::loadModelFromFile (object, "",
+                package, envModelName, srdfSuffix);
+            env = EnvironmentModel::fromDevice (object);
+            loaded (modelName, start, meshTriangles (object, ""), times);
+            if (cached) cache.store (key, env);
           }
 
-          copy (object->handles , robot->handles , robot, p);
-          copy (object->grippers, robot->grippers, robot, p);
+          env.insert (problemSolver(), robot, p, mergeEnvironment ());
           robot->didInsertRobot (p.substr(0, p.size() - 1));
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw hpp::Error (exc.what ());
 	}
@@ -308,54 +532,114 @@ namespace hpp {
 	throw (hpp::Error)
       {
 	try {
+          const ServerMetrics::value_type start = ServerMetrics::now ();
           DevicePtr_t robot = getRobotOrThrow (problemSolver());
 
           std::string p (prefix);
-          DevicePtr_t object = Device::create (p);
-          // TODO replace "" by p and remove `p +` in what follows
-          pinocchio::urdf::loadModelFromString (object, 0, "",
-              "anchor", urdfString, srdfString);
-          srdf::loadModelFromXML (object, "", srdfString);
-          object->controlComputation(Device::JOINT_POSITION);
-          object->computeForwardKinematics();
-          object->updateGeometryPlacements();
-
-	  // Detach objects from joints
-          using pinocchio::DeviceObjectVector;
-          DeviceObjectVector& objects = object->objectVector();
-          for (DeviceObjectVector::iterator itObj = objects.begin();
-              itObj != objects.end(); ++itObj) {
-            problemSolver()->addObstacle (
-                p + (*itObj)->name (),
-                *(*itObj)->fcl (),
-                true, true);
-	    hppDout (info, "Adding obstacle " << obj->name ());
-	  }
-          typedef core::Container<JointAndShapes_t>::Map_t ShapeMap;
-          const ShapeMap& m = object->jointAndShapes.map;
-          for (ShapeMap::const_iterator it = m.begin ();
-              it != m.end (); it++) {
-            JointAndShapes_t shapes;
-            for (JointAndShapes_t::const_iterator itT = it->second.begin ();
-                itT != it->second.end(); ++itT) {
-              const Transform3f& M = itT->first->currentTransformation ();
-              Shape_t newShape (itT->second.size());
-              for (std::size_t i = 0; i < newShape.size (); ++i)
-                newShape [i] = M.act (itT->second[i]);
-              shapes.push_back (JointAndShape_t (JointPtr_t(), newShape));
-            }
-            problemSolver()->jointAndShapes.add (p + it->first, shapes);
+          ModelCache& cache = server_->modelCache ();
+          std::string key;
+          if (cache.enabled ())
+            key = cache.key (urdfString, srdfString, "anchor");
+
+          EnvironmentModel env;
+          ModelCache::LoadTimes_t times;
+          if (cache.enabled () && cache.load (key, env, &times)) {
+            loaded (times);
+          } else {
+            DevicePtr_t object = Device::create (p);
+            // TODO replace "" by p and remove `p +` in what follows
+            loadModelFromString (object, "", "anchor", urdfString,
+                srdfString, times);
+            srdf::loadModelFromXML (object, "", srdfString);
+            env = EnvironmentModel::fromDevice (object);
+            loaded (p, start, meshTriangles (object, ""), times);
+            if (cache.enabled ()) cache.store (key, env);
           }
 
-          copy (object->handles , robot->handles , robot, p);
-          copy (object->grippers, robot->grippers, robot, p);
+          env.insert (problemSolver(), robot, p, mergeEnvironment ());
           robot->didInsertRobot (p.substr(0, p.size() - 1));
-          problemSolver()->resetProblem ();
+          resetProblem ();
 	} catch (const std::exception& exc) {
 	  throw hpp::Error (exc.what ());
 	}
       }
 
+      void Robot::getLoadTimes (Names_t_out names, floatSeq_out seconds)
+        throw (hpp::Error)
+      {
+        ModelCache::LoadTimes_t times;
+        {
+          boost::mutex::scoped_lock lock (loadTimesMutex_);
+          times = loadTimes_;
+        }
+        std::vector <std::string> n (times.size ());
+        floatSeq* s = new floatSeq ();
+        s->length ((CORBA::ULong) times.size ());
+        for (std::size_t i = 0; i < times.size (); ++i) {
+          n[i] = times[i].name;
+          (*s)[(CORBA::ULong) i] = times[i].seconds;
+        }
+        names = toNames_t (n.begin (), n.end ());
+        seconds = s;
+      }
+
+      void Robot::mergeEnvironmentObstacles (CORBA::Boolean merge)
+        throw (hpp::Error)
+      {
+        const std::string name (server_->problemSolverMap ()->selected_);
+        boost::mutex::scoped_lock lock (mergeEnvironmentMutex_);
+        if (merge) mergeEnvironment_.insert (name);
+        else mergeEnvironment_.erase (name);
+      }
+
+      bool Robot::mergeEnvironment ()
+      {
+        const std::string name (server_->problemSolverMap ()->selected_);
+        boost::mutex::scoped_lock lock (mergeEnvironmentMutex_);
+        return mergeEnvironment_.count (name) > 0;
+      }
+
+      void Robot::beginSceneAssembly () throw (hpp::Error)
+      {
+        try {
+          server_->sceneAssemblies ().begin
+            (server_->problemSolverMap ()->selected_);
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      CORBA::ULong Robot::commitSceneAssembly () throw (hpp::Error)
+      {
+        try {
+          const std::string name (server_->problemSolverMap ()->selected_);
+          return endSceneAssembly (server_->sceneAssemblies ().commit (name));
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      CORBA::ULong Robot::abortSceneAssembly () throw (hpp::Error)
+      {
+        try {
+          const std::string name (server_->problemSolverMap ()->selected_);
+          return endSceneAssembly (server_->sceneAssemblies ().abort (name));
+        } catch (const std::exception& exc) {
+          throw hpp::Error (exc.what ());
+        }
+      }
+
+      CORBA::ULong Robot::endSceneAssembly (std::size_t inserted)
+      {
+        // The models inserted are kept, so the problem is reset either way.
+        if (inserted > 0) {
+          server_->projectionSessions ().drop
+            (server_->problemSolverMap ()->selected_);
+          problemSolver()->resetProblem ();
+        }
+        return (CORBA::ULong) inserted;
+      }
+
       Transform__slice* Robot::getRootJointPosition (const char* robotName)
         throw (Error)
       {
@@ -494,6 +778,102 @@ namespace hpp {
         }
       }
 
+      void Robot::addGrippers (const Names_t& linkNames,
+          const Names_t& gripperNames,
+          const floatSeqSeq& handlePositionsInJoint)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          std::vector <JointPtr_t> joints =
+            jointsOfLinks (problemSolver(), linkNames);
+          std::vector <Transform3f> T = toTransforms (handlePositionsInJoint);
+          checkNewNames (gripperNames, T.size (), &gripperExists, robot);
+          if (joints.size () != T.size ())
+            throw hpp::Error ("The arguments must have the same length.");
+
+          se3::Model& model = robot->model();
+          model.frames.reserve (model.frames.size () + T.size ());
+          for (std::size_t i = 0; i < T.size (); ++i) {
+            const CORBA::ULong k = (CORBA::ULong) i;
+            model.addFrame (se3::Frame (std::string (gripperNames[k]),
+                  joints[i]->index (), model.getFrameId (joints[i]->name ()),
+                  T[i], se3::OP_FRAME));
+          }
+          for (CORBA::ULong i = 0; i < gripperNames.length (); ++i) {
+            GripperPtr_t gripper = Gripper::create (
+                std::string (gripperNames[i]), robot);
+            robot->grippers.add (gripper->name (), gripper);
+          }
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      void Robot::addHandles (const Names_t& linkNames,
+          const Names_t& handleNames, const floatSeqSeq& localPositions,
+          const intSeqSeq& masks)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          std::vector <JointPtr_t> joints =
+            jointsOfLinks (problemSolver(), linkNames);
+          std::vector <Transform3f> T = toTransforms (localPositions);
+          checkNewNames (handleNames, T.size (), &handleExists, robot);
+          if (joints.size () != T.size ()
+              || (masks.length () != 0 && masks.length () != T.size ()))
+            throw hpp::Error ("The arguments must have the same length.");
+          for (CORBA::ULong i = 0; i < masks.length (); ++i)
+            if (masks[i].length () != 6)
+              throw hpp::Error ("A mask must have 6 values.");
+
+          for (std::size_t i = 0; i < T.size (); ++i) {
+            const CORBA::ULong k = (CORBA::ULong) i;
+            HandlePtr_t handle = Handle::create (std::string (handleNames[k]),
+                T[i], joints[i]);
+            if (masks.length () > 0) {
+              std::vector <bool> mask (6);
+              for (CORBA::ULong j = 0; j < 6; ++j)
+                mask [j] = (masks[k][j] != 0);
+              handle->mask (mask);
+            }
+            robot->handles.add (handle->name (), handle);
+          }
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      Names_t* Robot::getGripperPositions (const floatSeq& config,
+          Names_t_out jointNames, floatSeqSeq_out positionsInJoint,
+          floatSeqSeq_out worldPositions)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          return positions <GripperPtr_t, GripperPosition> (robot,
+              robot->grippers, config, jointNames, positionsInJoint,
+              worldPositions);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
+
+      Names_t* Robot::getHandlePositions (const floatSeq& config,
+          Names_t_out jointNames, floatSeqSeq_out positionsInJoint,
+          floatSeqSeq_out worldPositions)
+        throw (hpp::Error)
+      {
+        try {
+          DevicePtr_t robot = getRobotOrThrow (problemSolver());
+          return positions <HandlePtr_t, HandlePosition> (robot,
+              robot->handles, config, jointNames, positionsInJoint,
+              worldPositions);
+        } catch (const std::exception& exc) {
+          throw Error (exc.what ());
+        }
+      }
     } // namespace impl
   } // namespace manipulation
 } // namespace hpp
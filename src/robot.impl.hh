@@ -18,10 +18,17 @@
 #ifndef HPP_MANIPULATION_CORBA_ROBOT_IMPL_HH
 # define HPP_MANIPULATION_CORBA_ROBOT_IMPL_HH
 
+# include <set>
+
+# include <boost/thread/mutex.hpp>
+
 # include <hpp/corbaserver/manipulation/fwd.hh>
 # include <hpp/manipulation/problem-solver.hh>
 # include "hpp/corbaserver/manipulation/robot.hh"
 
+# include "metrics.hh"
+# include "model-cache.hh"
+
 namespace hpp {
   namespace manipulation {
     namespace impl {
@@ -37,6 +44,9 @@ namespace hpp {
             server_ = server;
           }
 
+          /// Record the statistics of the call in Server::metrics.
+          virtual CORBA::Boolean _dispatch (omniCallHandle& handle);
+
           virtual void finishedRobot (const char* robotName)
             throw (hpp::Error);
 
@@ -84,6 +94,18 @@ namespace hpp {
               const char* srdfString, const char* prefix)
             throw (hpp::Error);
 
+          virtual void getLoadTimes (Names_t_out names,
+              floatSeq_out seconds) throw (hpp::Error);
+
+          virtual void mergeEnvironmentObstacles (CORBA::Boolean merge)
+            throw (hpp::Error);
+
+          virtual void beginSceneAssembly () throw (hpp::Error);
+
+          virtual CORBA::ULong commitSceneAssembly () throw (hpp::Error);
+
+          virtual CORBA::ULong abortSceneAssembly () throw (hpp::Error);
+
           virtual Transform__slice* getRootJointPosition (const char* robotName)
             throw (hpp::Error);
 
@@ -111,9 +133,69 @@ namespace hpp {
               ::hpp::Transform__out position)
             throw (hpp::Error);
 
+          virtual void addGrippers (const Names_t& linkNames,
+              const Names_t& gripperNames,
+              const floatSeqSeq& handlePositionsInJoint)
+            throw (hpp::Error);
+
+          virtual void addHandles (const Names_t& linkNames,
+              const Names_t& handleNames, const floatSeqSeq& localPositions,
+              const intSeqSeq& masks)
+            throw (hpp::Error);
+
+          virtual Names_t* getGripperPositions (const floatSeq& config,
+              Names_t_out jointNames, floatSeqSeq_out positionsInJoint,
+              floatSeqSeq_out positions)
+            throw (hpp::Error);
+
+          virtual Names_t* getHandlePositions (const floatSeq& config,
+              Names_t_out jointNames, floatSeqSeq_out positionsInJoint,
+              floatSeqSeq_out positions)
+            throw (hpp::Error);
+
         private:
           ProblemSolverPtr_t problemSolver();
+          /// Reset the problem after a model insertion, unless a scene
+          /// assembly of the selected problem is in progress.
+          void resetProblem ();
+          /// Reset the problem at the end of a scene assembly, if models
+          /// were inserted.
+          /// \return inserted.
+          CORBA::ULong endSceneAssembly (std::size_t inserted);
+          /// Parse a model. Its collision meshes are read from the model
+          /// cache, if it is enabled.
+          /// \param imported filled with the time spent importing each mesh
+          ///        missing from the cache.
+          void loadModel (const DevicePtr_t& robot, const std::string& name,
+              const std::string& rootJointType, const std::string& package,
+              const std::string& modelName, const std::string& urdfSuffix,
+              const std::string& srdfSuffix,
+              ModelCache::LoadTimes_t& imported);
+          /// Parse a model from strings, as loadModel.
+          void loadModelFromString (const DevicePtr_t& robot,
+              const std::string& name, const std::string& rootJointType,
+              std::string urdf, const std::string& srdf,
+              ModelCache::LoadTimes_t& imported);
+          /// Record the time spent importing the meshes missing from the
+          /// model cache and parsing a whole model.
+          /// \param triangles number of triangles of its meshes.
+          void loaded (const std::string& name,
+              ServerMetrics::value_type start, std::size_t triangles,
+              const ModelCache::LoadTimes_t& imported);
+          /// Record the time spent building the BVH of each mesh of an
+          /// environment read from the model cache.
+          void loaded (const ModelCache::LoadTimes_t& times);
+
+          /// Whether the environments loaded in the selected problem are
+          /// merged.
+          bool mergeEnvironment ();
+
           Server* server_;
+          /// Names of the problems in which environments are merged.
+          std::set <std::string> mergeEnvironment_;
+          boost::mutex mergeEnvironmentMutex_;
+          ModelCache::LoadTimes_t loadTimes_;
+          boost::mutex loadTimesMutex_;
       }; // class Robot
     } // namespace impl
   } // namespace manipulation
@@ -0,0 +1,116 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "scene-assemblies.hh"
+
+#include <set>
+#include <stdexcept>
+
+#include <omniORB4/CORBA.h>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        typedef std::set <std::string> Operations_t;
+
+        // Operations allowed during the assembly of the selected problem:
+        // the insertions, the end of the assembly, the reset of the problem
+        // and the queries that do not read the problem.
+        const char* robotDuringAssembly [] = {
+          "insertRobotModel", "insertRobotModelFromString",
+          "insertRobotSRDFModel", "insertHumanoidModel",
+          "insertHumanoidModelFromString", "insertObjectModel",
+          "loadEnvironmentModel", "loadEnvironmentModelFromString",
+          "mergeEnvironmentObstacles", "getLoadTimes", "beginSceneAssembly",
+          "commitSceneAssembly", "abortSceneAssembly"
+        };
+
+        const char* problemDuringAssembly [] = {
+          "selectProblem", "resetProblem", "getServerMetrics",
+          "resetServerMetrics", "getQueueMetrics", "getVersions"
+        };
+
+        template <std::size_t N>
+        Operations_t toSet (const char* (&ops) [N])
+        {
+          return Operations_t (ops, ops + N);
+        }
+
+        bool allowedDuringAssembly (const std::string& interfaceName,
+            const std::string& operation)
+        {
+          static const Operations_t robot (toSet (robotDuringAssembly));
+          static const Operations_t problem (toSet (problemDuringAssembly));
+          if (interfaceName == "Robot") return robot.count (operation) > 0;
+          if (interfaceName == "Problem") return problem.count (operation) > 0;
+          return false;
+        }
+      }
+
+      void SceneAssemblies::begin (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (!assemblies_.insert (std::make_pair (problemName, 0)).second)
+          throw std::runtime_error ("A scene assembly of problem "
+              + problemName + " is already in progress.");
+      }
+
+      bool SceneAssemblies::inserted (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Assemblies_t::iterator it = assemblies_.find (problemName);
+        if (it == assemblies_.end ()) return false;
+        ++it->second;
+        return true;
+      }
+
+      std::size_t SceneAssemblies::commit (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Assemblies_t::iterator it = assemblies_.find (problemName);
+        if (it == assemblies_.end ())
+          throw std::runtime_error ("No scene assembly of problem "
+              + problemName + " is in progress.");
+        const std::size_t inserted = it->second;
+        assemblies_.erase (it);
+        return inserted;
+      }
+
+      std::size_t SceneAssemblies::abort (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Assemblies_t::iterator it = assemblies_.find (problemName);
+        if (it == assemblies_.end ()) return 0;
+        const std::size_t inserted = it->second;
+        assemblies_.erase (it);
+        return inserted;
+      }
+
+      void SceneAssemblies::checkAllowed (const std::string& problemName,
+          const char* interfaceName, const char* operation) const
+      {
+        // Operations of the base classes of the servants, like _is_a, do not
+        // read the problem.
+        if (operation[0] == '_') return;
+        if (allowedDuringAssembly (interfaceName, operation)) return;
+        boost::mutex::scoped_lock lock (mutex_);
+        if (assemblies_.count (problemName))
+          throw CORBA::BAD_INV_ORDER (0, CORBA::COMPLETED_NO);
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,74 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_SCENE_ASSEMBLIES_HH
+# define HPP_MANIPULATION_CORBA_SCENE_ASSEMBLIES_HH
+
+# include <map>
+# include <string>
+
+# include <boost/thread/mutex.hpp>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Scene assemblies in progress, by problem name.
+      ///
+      /// During the assembly of a problem, the insertions of models do not
+      /// reset the problem, which is reset once when the assembly ends. As
+      /// the problem is then out of date, the other operations of the
+      /// servants on this problem are refused until the assembly is
+      /// committed or aborted, or the problem is reset.
+      class SceneAssemblies
+      {
+        public:
+          /// \throw std::runtime_error if an assembly of the problem is
+          ///        in progress.
+          void begin (const std::string& problemName);
+
+          /// Count an insertion in the assembly of a problem.
+          /// \return whether an assembly of the problem is in progress.
+          bool inserted (const std::string& problemName);
+
+          /// End the assembly of a problem.
+          /// \return the number of insertions.
+          /// \throw std::runtime_error if no assembly of the problem is in
+          ///        progress.
+          std::size_t commit (const std::string& problemName);
+
+          /// End the assembly of a problem, if any.
+          /// \return the number of insertions, 0 if no assembly was in
+          ///         progress.
+          std::size_t abort (const std::string& problemName);
+
+          /// Refuse an operation of a servant during the assembly of the
+          /// problem, unless it inserts a model or ends the assembly.
+          /// \throw CORBA::BAD_INV_ORDER if the operation is refused.
+          void checkAllowed (const std::string& problemName,
+              const char* interfaceName, const char* operation) const;
+
+        private:
+          typedef std::map <std::string, std::size_t> Assemblies_t;
+
+          mutable boost::mutex mutex_;
+          /// Number of insertions of each assembly.
+          Assemblies_t assemblies_;
+      }; // class SceneAssemblies
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_SCENE_ASSEMBLIES_HH
@@ -0,0 +1,152 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "scheduler.hh"
+
+#include <stdexcept>
+
+#include <omniORB4/CORBA.h>
+
+#include "metrics.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        const char* heavyOperations [] = {
+          "Graph.autoBuild", "Graph.initialize",
+          "Graph.computeGraspFeasibility", "Graph.analyze",
+          "Graph.completeInitialization",
+          "Problem.buildAndProjectPath", "Problem.generateValidConfigsInState",
+          "Problem.exportRoadmap", "Problem.importRoadmap",
+          "Problem.validateConfigurations",
+          "Robot.insertRobotModel", "Robot.insertObjectModel",
+          "Robot.insertRobotModelFromString", "Robot.insertHumanoidModel",
+          "Robot.insertHumanoidModelFromString", "Robot.loadEnvironmentModel",
+          "Robot.loadEnvironmentModelFromString", "Robot.commitSceneAssembly",
+          "Robot.abortSceneAssembly"
+        };
+      }
+
+      Scheduler::Ticket::Ticket (Scheduler& scheduler,
+          const char* interfaceName, const char* operation) :
+        scheduler_ (scheduler), class_ (0x0)
+      {
+        boost::mutex::scoped_lock lock (scheduler_.mutex_);
+        Class* c = scheduler_.classOf (interfaceName, operation);
+        Queue& q = c->queue;
+        if (q.slots != 0 && (q.running >= q.slots || c->head != c->tail)) {
+          if (q.depth >= q.bound) {
+            ++q.rejected;
+            throw CORBA::TRANSIENT (0, CORBA::COMPLETED_NO);
+          }
+          const value_type start = ServerMetrics::now ();
+          const value_type arrival = c->tail++;
+          ++q.depth;
+          if (q.depth > q.maxDepth) q.maxDepth = q.depth;
+          // The slot limit is read at each wake up as it may be changed.
+          while (c->head != arrival
+              || (q.slots != 0 && q.running >= q.slots))
+            c->changed.wait (lock);
+          ++c->head;
+          --q.depth;
+          q.wait.record (ServerMetrics::now () - start);
+          // The next request may be admitted as well.
+          c->changed.notify_all ();
+        } else {
+          q.wait.record (0);
+        }
+        ++q.running;
+        ++q.admitted;
+        class_ = c;
+      }
+
+      Scheduler::Ticket::~Ticket ()
+      {
+        boost::mutex::scoped_lock lock (scheduler_.mutex_);
+        --class_->queue.running;
+        class_->changed.notify_all ();
+      }
+
+      Scheduler::Scheduler ()
+      {
+        setClass ("default", 0, 0);
+        setClass ("heavy", 2, 32);
+        const std::size_t n =
+          sizeof (heavyOperations) / sizeof (heavyOperations[0]);
+        for (std::size_t i = 0; i < n; ++i)
+          route (heavyOperations[i], "heavy");
+      }
+
+      Scheduler::~Scheduler ()
+      {
+        for (Classes_t::iterator it = classes_.begin ();
+            it != classes_.end (); ++it)
+          delete it->second;
+      }
+
+      void Scheduler::setClass (const std::string& name, std::size_t slots,
+          std::size_t bound)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Class*& c = classes_ [name];
+        if (c == 0x0) {
+          c = new Class;
+          c->queue.name = name;
+        }
+        c->queue.slots = slots;
+        c->queue.bound = bound;
+        c->changed.notify_all ();
+      }
+
+      void Scheduler::route (const std::string& operation,
+          const std::string& className)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (classes_.find (className) == classes_.end ())
+          throw std::invalid_argument ("No priority class " + className);
+        routes_ [operation] = className;
+      }
+
+      Scheduler::Queues_t Scheduler::snapshot (bool reset)
+      {
+        Queues_t queues;
+        boost::mutex::scoped_lock lock (mutex_);
+        queues.reserve (classes_.size ());
+        for (Classes_t::iterator it = classes_.begin ();
+            it != classes_.end (); ++it) {
+          Queue& q = it->second->queue;
+          queues.push_back (q);
+          if (reset) {
+            q.maxDepth = q.depth;
+            q.admitted = q.rejected = 0;
+            q.wait.reset ();
+          }
+        }
+        return queues;
+      }
+
+      Scheduler::Class* Scheduler::classOf (const char* interfaceName,
+          const char* operation)
+      {
+        std::map <std::string, std::string>::const_iterator it =
+          routes_.find (std::string (interfaceName) + '.' + operation);
+        if (it == routes_.end ()) it = routes_.find (operation);
+        return classes_ [it == routes_.end () ? "default" : it->second];
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,140 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_SCHEDULER_HH
+# define HPP_MANIPULATION_CORBA_SCHEDULER_HH
+
+# include <map>
+# include <string>
+# include <vector>
+
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/condition_variable.hpp>
+
+# include "latency-histogram.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Admission of the requests to the manipulation servants.
+      ///
+      /// Each operation is routed to a priority class. A class runs at most
+      /// a given number of requests at the same time and queues at most a
+      /// given number of requests; further requests are rejected with
+      /// CORBA::TRANSIENT. Queued requests are admitted in arrival order.
+      ///
+      /// Limiting the slots of the class of the long operations keeps ORB
+      /// threads available for the short queries, which are routed to the
+      /// unlimited class \c default. Queued requests hold their ORB thread
+      /// while they wait, so with a pool of threads, the running and queued
+      /// requests of the limited classes must be fewer than the threads of
+      /// the pool.
+      class Scheduler
+      {
+        private:
+          struct Class;
+
+        public:
+          typedef LatencyHistogram::value_type value_type;
+
+          /// State and statistics of a class.
+          struct Queue {
+            std::string name;
+            /// Maximal number of running requests, 0 for no limit.
+            std::size_t slots;
+            /// Maximal number of queued requests.
+            std::size_t bound;
+            std::size_t running;
+            std::size_t depth;
+            std::size_t maxDepth;
+            value_type admitted;
+            value_type rejected;
+            /// Time spent in the queue by the admitted requests.
+            LatencyHistogram wait;
+
+            Queue () : slots (0), bound (0), running (0), depth (0),
+              maxDepth (0), admitted (0), rejected (0) {}
+          };
+          typedef std::vector <Queue> Queues_t;
+
+          /// Admission of a request, released at destruction.
+          ///
+          /// Create an instance on the stack of the servant dispatch
+          /// method, before the operation is executed. The constructor
+          /// blocks until the request is admitted.
+          class Ticket
+          {
+            public:
+              /// \throw CORBA::TRANSIENT if the queue of the class is full.
+              Ticket (Scheduler& scheduler, const char* interfaceName,
+                  const char* operation);
+              ~Ticket ();
+
+            private:
+              Scheduler& scheduler_;
+              Class* class_;
+          }; // class Ticket
+
+          /// Create classes \c default, unlimited, and \c heavy, which runs
+          /// two requests and queues 32 requests. Model loading, graph
+          /// initialization, Graph.autoBuild and
+          /// Problem.buildAndProjectPath are routed to \c heavy.
+          Scheduler ();
+          ~Scheduler ();
+
+          /// Create or modify a class.
+          /// \param slots maximal number of running requests, 0 for no
+          ///        limit.
+          /// \param bound maximal number of queued requests.
+          void setClass (const std::string& name, std::size_t slots,
+              std::size_t bound);
+
+          /// Route an operation to a class.
+          /// \param operation either "Interface.operation", as in
+          ///        "Problem.buildAndProjectPath", or the operation name
+          ///        alone, which applies to all the interfaces.
+          /// \throw std::invalid_argument if the class does not exist.
+          void route (const std::string& operation,
+              const std::string& className);
+
+          /// Copy of the state and statistics of the classes.
+          /// \param reset whether to reset the statistics after the copy.
+          Queues_t snapshot (bool reset);
+
+        private:
+          struct Class {
+            Queue queue;
+            /// Arrival number of the next queued request.
+            value_type tail;
+            /// Arrival number of the next request to admit.
+            value_type head;
+            boost::condition_variable changed;
+
+            Class () : tail (0), head (0) {}
+          };
+          typedef std::map <std::string, Class*> Classes_t;
+
+          Class* classOf (const char* interfaceName, const char* operation);
+
+          boost::mutex mutex_;
+          Classes_t classes_;
+          std::map <std::string, std::string> routes_;
+      }; // class Scheduler
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_SCHEDULER_HH
@@ -17,16 +17,38 @@
 // License along with hpp-manipulation-corba.  If not, see
 // <http://www.gnu.org/licenses/>.
 
+#include <cstdlib>
+
 #include <hpp/util/exception.hh>
 #include <hpp/corbaserver/manipulation/server.hh>
 #include "graph.impl.hh"
 #include "problem.impl.hh"
 #include "robot.impl.hh"
+#include "metrics.hh"
+#include "versions.hh"
+#include "scheduler.hh"
+#include "model-cache.hh"
+#include "roadmap-index.hh"
+#include "projection-cache.hh"
+#include "projection-sessions.hh"
+#include "scene-assemblies.hh"
+#include "lazy-components.hh"
+#include "solve-jobs.hh"
 
 namespace hpp {
   namespace manipulation {
     Server::Server (int argc, const char* argv[], bool multiThread,
 		    const std::string& poaName) : 
+      metrics_ (new impl::ServerMetrics ()),
+      versions_ (new impl::Versions ()),
+      scheduler_ (new impl::Scheduler ()),
+      modelCache_ (new impl::ModelCache ()),
+      roadmapIndex_ (new impl::RoadmapIndex ()),
+      projectionCache_ (new impl::ProjectionCache ()),
+      projectionSessions_ (new impl::ProjectionSessions ()),
+      sceneAssemblies_ (new impl::SceneAssemblies ()),
+      lazyComponents_ (new impl::LazyComponents (*projectionCache_)),
+      solveJobs_ (new impl::SolveJobs ()),
       graphImpl_ (new corba::Server <impl::Graph>
 		  (argc, argv, multiThread, poaName)),
       problemImpl_ (new corba::Server <impl::Problem>
@@ -34,6 +56,8 @@ namespace hpp {
       robotImpl_ (new corba::Server <impl::Robot>
 		  (argc, argv, multiThread, poaName))
     {
+      const char* cacheDir = std::getenv ("HPP_MANIPULATION_MODEL_CACHE");
+      if (cacheDir != NULL) modelCache_->directory (cacheDir);
       graphImpl_->implementation ().setServer (this);
       problemImpl_->implementation ().setServer (this);
       robotImpl_->implementation ().setServer (this);
@@ -44,6 +68,16 @@ namespace hpp {
       delete graphImpl_;
       delete problemImpl_;
       delete robotImpl_;
+      delete solveJobs_;
+      delete lazyComponents_;
+      delete sceneAssemblies_;
+      delete projectionSessions_;
+      delete projectionCache_;
+      delete roadmapIndex_;
+      delete modelCache_;
+      delete scheduler_;
+      delete versions_;
+      delete metrics_;
     }
 
     /// Start corba server
@@ -83,5 +117,22 @@ namespace hpp {
       return problemSolverMap_;
     }
 
+    hpp::corbaserver::manipulation::Graph_ptr Server::graph ()
+    {
+      // The servant has a single activation, in the POA of graphImpl_:
+      // omniORB returns a reference to it.
+      return graphImpl_->implementation ()._this ();
+    }
+
+    hpp::corbaserver::manipulation::Problem_ptr Server::problem ()
+    {
+      return problemImpl_->implementation ()._this ();
+    }
+
+    hpp::corbaserver::manipulation::Robot_ptr Server::robot ()
+    {
+      return robotImpl_->implementation ()._this ();
+    }
+
   } // namespace manipulation
 } // namespace hpp
@@ -0,0 +1,110 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "hpp/corbaserver/manipulation/shared-channel.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace hpp
+{
+  namespace corbaServer
+  {
+    namespace manipulation
+    {
+      namespace bi = boost::interprocess;
+
+      struct SharedChannelReader::Mapping {
+        bi::shared_memory_object shm;
+        bi::mapped_region region;
+
+        Mapping (const std::string& name) :
+          shm (bi::open_only, name.c_str (), bi::read_write),
+          region (shm, bi::read_write)
+        {}
+      };
+
+      SharedChannelReader::SharedChannelReader (const std::string& name)
+      {
+        try {
+          mapping_.reset (new Mapping (name));
+        } catch (const bi::interprocess_exception& e) {
+          throw std::runtime_error ("Cannot map shared channel " + name
+              + ": " + e.what ());
+        }
+        if (mapping_->region.get_size () < sizeof (ChannelHeader))
+          throw std::runtime_error ("Shared channel " + name + " is too small");
+        header_ = static_cast <ChannelHeader*>
+          (mapping_->region.get_address ());
+        if (header_->magic != CHANNEL_MAGIC
+            || header_->version != CHANNEL_VERSION
+            || mapping_->region.get_size ()
+            < sizeof (ChannelHeader) + header_->capacity)
+          throw std::runtime_error (name + " is not a compatible channel");
+        data_ = reinterpret_cast <const char*> (header_ + 1);
+      }
+
+      SharedChannelReader::~SharedChannelReader ()
+      {}
+
+      std::size_t SharedChannelReader::available () const
+      {
+        boost::uint64_t head = header_->head;
+        return (std::size_t) (head - header_->tail);
+      }
+
+      bool SharedChannelReader::read (Record& record)
+      {
+        const boost::uint64_t capacity = header_->capacity;
+        boost::uint64_t tail = header_->tail;
+        while (true) {
+          boost::uint64_t head = header_->head;
+          // Read the record after the head.
+          __sync_synchronize ();
+          if (tail == head) break;
+          boost::uint64_t pos = tail % capacity;
+          if (capacity - pos < sizeof (RecordHeader)) {
+            tail += capacity - pos;
+            continue;
+          }
+          RecordHeader h;
+          std::memcpy (&h, data_ + pos, sizeof (h));
+          tail += sizeof (RecordHeader) + h.size;
+          if (h.kind == RECORD_PADDING) continue;
+
+          record.kind = (RecordKind) h.kind;
+          record.sequence = h.sequence;
+          record.rows = (std::size_t) h.rows;
+          record.cols = h.cols;
+          record.data.resize (record.rows * record.cols);
+          if (!record.data.empty ())
+            std::memcpy (&record.data [0], data_ + pos + sizeof (h),
+                record.data.size () * sizeof (double));
+          // Release the space once the record is copied.
+          __sync_synchronize ();
+          header_->tail = tail;
+          return true;
+        }
+        // Release the skipped padding.
+        header_->tail = tail;
+        return false;
+      }
+    } // end of namespace manipulation.
+  } // end of namespace corbaServer.
+} // end of namespace hpp.
@@ -0,0 +1,182 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "shared-channels.hh"
+
+#include <unistd.h>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace bi = boost::interprocess;
+      using corbaServer::manipulation::ChannelHeader;
+      using corbaServer::manipulation::RecordHeader;
+
+      struct SharedChannel::Mapping {
+        const std::string name;
+        bi::shared_memory_object shm;
+        bi::mapped_region region;
+
+        Mapping (const std::string& n, std::size_t size) :
+          name (n), shm (bi::create_only, n.c_str (), bi::read_write)
+        {
+          try {
+            shm.truncate ((bi::offset_t) size);
+            region = bi::mapped_region (shm, bi::read_write);
+          } catch (...) {
+            bi::shared_memory_object::remove (name.c_str ());
+            throw;
+          }
+        }
+
+        ~Mapping ()
+        {
+          bi::shared_memory_object::remove (name.c_str ());
+        }
+      };
+
+      SharedChannel::SharedChannel (const std::string& name,
+          std::size_t capacity) :
+        name_ (name), sequence_ (0)
+      {
+        capacity = (capacity + 7) & ~(std::size_t) 7;
+        if (capacity < 2 * sizeof (RecordHeader))
+          throw std::runtime_error ("Capacity of shared channel too small");
+        try {
+          mapping_.reset (new Mapping (name,
+                sizeof (ChannelHeader) + capacity));
+        } catch (const bi::interprocess_exception& e) {
+          throw std::runtime_error ("Cannot create shared channel " + name
+              + ": " + e.what ());
+        }
+        header_ = static_cast <ChannelHeader*>
+          (mapping_->region.get_address ());
+        std::memset (header_, 0, sizeof (ChannelHeader));
+        header_->capacity = capacity;
+        header_->version = corbaServer::manipulation::CHANNEL_VERSION;
+        data_ = reinterpret_cast <char*> (header_ + 1);
+        // A reader checks the magic number last.
+        __sync_synchronize ();
+        header_->magic = corbaServer::manipulation::CHANNEL_MAGIC;
+      }
+
+      SharedChannel::~SharedChannel ()
+      {}
+
+      std::size_t SharedChannel::size () const
+      {
+        return mapping_->region.get_size ();
+      }
+
+      boost::uint64_t SharedChannel::write (RecordKind kind, std::size_t rows,
+          std::size_t cols, const Fill_t& fill)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        const boost::uint64_t capacity = header_->capacity;
+        const boost::uint64_t size = rows * cols * sizeof (double);
+        const boost::uint64_t need = sizeof (RecordHeader) + size;
+        if (need > capacity) {
+          std::ostringstream oss;
+          oss << "Record of " << need << " bytes larger than shared channel "
+            << name_ << " (" << capacity << " bytes).";
+          throw std::runtime_error (oss.str ());
+        }
+        boost::uint64_t head = header_->head;
+        const boost::uint64_t tail = header_->tail;
+        boost::uint64_t pos = head % capacity;
+        // Records do not wrap around the end of the ring.
+        const boost::uint64_t skip =
+          (capacity - pos < need ? capacity - pos : 0);
+        if (need + skip > capacity - (head - tail)) {
+          std::ostringstream oss;
+          oss << "Shared channel " << name_ << " is full: "
+            << capacity - (head - tail) << " bytes free, " << need + skip
+            << " needed.";
+          throw std::runtime_error (oss.str ());
+        }
+        if (skip >= sizeof (RecordHeader)) {
+          RecordHeader padding;
+          padding.kind = corbaServer::manipulation::RECORD_PADDING;
+          padding.cols = 0;
+          padding.sequence = 0;
+          padding.rows = 0;
+          padding.size = skip - sizeof (RecordHeader);
+          std::memcpy (data_ + pos, &padding, sizeof (padding));
+        }
+        head += skip;
+        pos = head % capacity;
+
+        RecordHeader h;
+        h.kind = kind;
+        h.cols = (boost::uint32_t) cols;
+        h.sequence = sequence_;
+        h.rows = rows;
+        h.size = size;
+        std::memcpy (data_ + pos, &h, sizeof (h));
+        if (size > 0)
+          fill (reinterpret_cast <double*> (data_ + pos + sizeof (h)));
+        // Publish the record once written.
+        __sync_synchronize ();
+        header_->head = head + need;
+        return sequence_++;
+      }
+
+      SharedChannels::SharedChannels () : nextId_ (0)
+      {}
+
+      SharedChannelPtr_t SharedChannels::open (std::size_t capacity,
+          std::size_t& id)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        std::ostringstream name;
+        name << "hpp-manipulation-" << ::getpid () << "-" << nextId_;
+        SharedChannelPtr_t channel (new SharedChannel (name.str (), capacity));
+        id = nextId_++;
+        channels_ [id] = channel;
+        return channel;
+      }
+
+      SharedChannelPtr_t SharedChannels::get (std::size_t id) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Channels_t::const_iterator it = channels_.find (id);
+        if (it == channels_.end ()) {
+          std::ostringstream oss;
+          oss << "No shared channel with id " << id;
+          throw std::out_of_range (oss.str ());
+        }
+        return it->second;
+      }
+
+      void SharedChannels::close (std::size_t id)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        if (channels_.erase (id) == 0) {
+          std::ostringstream oss;
+          oss << "No shared channel with id " << id;
+          throw std::out_of_range (oss.str ());
+        }
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,109 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_SHARED_CHANNELS_HH
+# define HPP_MANIPULATION_CORBA_SHARED_CHANNELS_HH
+
+# include <map>
+# include <string>
+
+# include <boost/cstdint.hpp>
+# include <boost/function.hpp>
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include <hpp/corbaserver/manipulation/shared-channel.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Server side of a shared-memory channel.
+      ///
+      /// The shared-memory object is created by the constructor and
+      /// removed by the destructor.
+      /// \sa hpp::corbaServer::manipulation::SharedChannelReader for the
+      ///     layout.
+      class SharedChannel
+      {
+        public:
+          typedef corbaServer::manipulation::RecordKind RecordKind;
+          /// Write the row-major matrix in the given memory.
+          typedef boost::function <void (double*)> Fill_t;
+
+          /// \param capacity size of the ring in bytes, rounded up to a
+          ///        multiple of 8.
+          /// \throw std::runtime_error if the object cannot be created.
+          SharedChannel (const std::string& name, std::size_t capacity);
+
+          ~SharedChannel ();
+
+          const std::string& name () const
+          {
+            return name_;
+          }
+
+          /// Size of the shared-memory object.
+          std::size_t size () const;
+
+          /// Append a record.
+          ///
+          /// fill is called with the address of the record data in the
+          /// ring, so that the data is written once.
+          /// \return the sequence number of the record.
+          /// \throw std::runtime_error if the free space is insufficient.
+          boost::uint64_t write (RecordKind kind, std::size_t rows,
+              std::size_t cols, const Fill_t& fill);
+
+        private:
+          struct Mapping;
+
+          const std::string name_;
+          boost::shared_ptr <Mapping> mapping_;
+          corbaServer::manipulation::ChannelHeader* header_;
+          char* data_;
+          boost::mutex mutex_;
+          boost::uint64_t sequence_;
+      }; // class SharedChannel
+      typedef boost::shared_ptr <SharedChannel> SharedChannelPtr_t;
+
+      /// Shared-memory channels opened by the clients.
+      class SharedChannels
+      {
+        public:
+          SharedChannels ();
+
+          /// Create a channel named after the process and the channel id.
+          SharedChannelPtr_t open (std::size_t capacity, std::size_t& id);
+
+          /// \throw std::out_of_range if no channel has this id.
+          SharedChannelPtr_t get (std::size_t id) const;
+
+          /// Remove a channel. It is destroyed when no longer used.
+          /// \throw std::out_of_range if no channel has this id.
+          void close (std::size_t id);
+
+        private:
+          typedef std::map <std::size_t, SharedChannelPtr_t> Channels_t;
+
+          mutable boost::mutex mutex_;
+          Channels_t channels_;
+          std::size_t nextId_;
+      }; // class SharedChannels
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_SHARED_CHANNELS_HH
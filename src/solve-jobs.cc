@@ -0,0 +1,347 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "solve-jobs.hh"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <omniORB4/CORBA.h>
+
+#include <hpp/util/debug.hh>
+#include <hpp/core/roadmap.hh>
+#include <hpp/core/path-vector.hh>
+#include <hpp/manipulation/problem-solver.hh>
+
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        bool isTerminal (SolveJob::State s)
+        {
+          return s == SolveJob::SUCCESS || s == SolveJob::FAILURE
+            || s == SolveJob::CANCELLED;
+        }
+
+        typedef std::set <std::string> Operations_t;
+
+        // Operations allowed while a job runs on the selected problem. They
+        // only read the jobs, the metrics, the statistics and the version
+        // stamps, which are protected by their own mutexes, or select
+        // another problem. Any other operation may read or write the robot,
+        // the graph or the paths used by the planner.
+        const char* graphDuringJob [] = {
+          "getInitializeTimes", "getLazyInitializationStats"
+        };
+
+        const char* problemDuringJob [] = {
+          "selectProblem", "getSolveStatus", "getSolveEdgeStats",
+          "cancelSolve", "waitSolve", "getServerMetrics",
+          "resetServerMetrics", "getQueueMetrics", "getProjectionCacheStats",
+          "getVersions"
+        };
+
+        const char* robotDuringJob [] = {
+          "getLoadTimes"
+        };
+
+        template <std::size_t N>
+        Operations_t toSet (const char* (&ops) [N])
+        {
+          return Operations_t (ops, ops + N);
+        }
+
+        bool allowedDuringJob (const std::string& interfaceName,
+            const std::string& operation)
+        {
+          static const Operations_t graph (toSet (graphDuringJob));
+          static const Operations_t problem (toSet (problemDuringJob));
+          static const Operations_t robot (toSet (robotDuringJob));
+          if (interfaceName == "Graph") return graph.count (operation) > 0;
+          if (interfaceName == "Problem") return problem.count (operation) > 0;
+          if (interfaceName == "Robot") return robot.count (operation) > 0;
+          return false;
+        }
+
+        bool waitUntilTerminal (boost::mutex::scoped_lock& lock,
+            boost::condition_variable& cond, const SolveJob::Status& status,
+            double timeout)
+        {
+          if (timeout < 0) {
+            while (!isTerminal (status.state)) cond.wait (lock);
+            return true;
+          }
+          boost::system_time deadline = boost::get_system_time ()
+            + boost::posix_time::microseconds ((long) (timeout * 1e6));
+          while (!isTerminal (status.state))
+            if (!cond.timed_wait (lock, deadline)) break;
+          return isTerminal (status.state);
+        }
+      }
+
+      SolveJob::SolveJob (std::size_t id, ProblemSolverPtr_t problemSolver) :
+        id_ (id), problemSolver_ (problemSolver), cancelRequested_ (false)
+      {
+        status_.state = PENDING;
+        status_.iterations = 0;
+        status_.nbNodes = 0;
+        status_.nbEdges = 0;
+        status_.nbConnectedComponents = 0;
+        status_.elapsed = 0;
+        status_.pathId = -1;
+      }
+
+      SolveJob::Status SolveJob::status () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Status s (status_);
+        if (s.state == RUNNING)
+          s.elapsed = (double) (boost::posix_time::microsec_clock::universal_time ()
+              - start_).total_microseconds () * 1e-6;
+        return s;
+      }
+
+      bool SolveJob::finished () const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return isTerminal (status_.state);
+      }
+
+      bool SolveJob::cancel (double timeout)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        cancelRequested_ = true;
+        return waitUntilTerminal (lock, finished_, status_, timeout);
+      }
+
+      bool SolveJob::wait (double timeout) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return waitUntilTerminal (lock, finished_, status_, timeout);
+      }
+
+      void SolveJob::run ()
+      {
+        {
+          boost::mutex::scoped_lock lock (mutex_);
+          if (cancelRequested_) {
+            status_.state = CANCELLED;
+            finished_.notify_all ();
+            return;
+          }
+          status_.state = RUNNING;
+          start_ = boost::posix_time::microsec_clock::universal_time ();
+        }
+        try {
+          bool solved;
+          {
+            boost::mutex::scoped_lock step (stepMutex_);
+            solved = problemSolver_->prepareSolveStepByStep ();
+          }
+          updateProgress (0);
+          const std::size_t maxIter = problemSolver_->maxIterPathPlanning ();
+          std::size_t iter = 0;
+          while (!solved) {
+            {
+              boost::mutex::scoped_lock lock (mutex_);
+              if (cancelRequested_) break;
+            }
+            if (iter >= maxIter) {
+              terminate (FAILURE, "Maximal number of iterations reached.");
+              return;
+            }
+            {
+              boost::mutex::scoped_lock step (stepMutex_);
+              solved = problemSolver_->executeOneStep ();
+            }
+            ++iter;
+            updateProgress (iter);
+          }
+          if (!solved) {
+            terminate (CANCELLED);
+            return;
+          }
+          long pathId;
+          {
+            boost::mutex::scoped_lock step (stepMutex_);
+            problemSolver_->finishSolveStepByStep ();
+            problemSolver_->optimizePath (problemSolver_->paths ().back ());
+            pathId = (long) problemSolver_->paths ().size () - 1;
+          }
+          boost::mutex::scoped_lock lock (mutex_);
+          status_.pathId = pathId;
+        } catch (const std::exception& exc) {
+          hppDout (error, "Planning job " << id_ << " failed: " << exc.what ());
+          terminate (FAILURE, exc.what ());
+          return;
+        }
+        terminate (SUCCESS);
+      }
+
+      void SolveJob::updateProgress (std::size_t iterations)
+      {
+        core::RoadmapPtr_t roadmap = problemSolver_->roadmap ();
+        boost::mutex::scoped_lock lock (mutex_);
+        status_.iterations = iterations;
+        if (roadmap) {
+          status_.nbNodes = roadmap->nodes ().size ();
+          status_.nbEdges = roadmap->edges ().size ();
+          status_.nbConnectedComponents =
+            roadmap->connectedComponents ().size ();
+        }
+      }
+
+      void SolveJob::terminate (State state, const std::string& error)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        status_.state = state;
+        status_.error = error;
+        status_.elapsed = (double) (boost::posix_time::microsec_clock::universal_time ()
+            - start_).total_microseconds () * 1e-6;
+        finished_.notify_all ();
+      }
+
+      std::string SolveJob::toString (State state)
+      {
+        switch (state) {
+          case PENDING:   return "pending";
+          case RUNNING:   return "running";
+          case SUCCESS:   return "success";
+          case FAILURE:   return "failure";
+          case CANCELLED: return "cancelled";
+        }
+        return "unknown";
+      }
+
+      SolveJobs::SolveJobs (std::size_t nbThreads, std::size_t history) :
+        nextId_ (0), history_ (history), stop_ (false)
+      {
+        if (nbThreads == 0)
+          nbThreads = std::max (1u, boost::thread::hardware_concurrency ());
+        for (std::size_t i = 0; i < nbThreads; ++i)
+          threads_.create_thread (boost::bind (&SolveJobs::work, this));
+      }
+
+      SolveJobs::~SolveJobs ()
+      {
+        std::vector <SolveJobPtr_t> running;
+        {
+          boost::mutex::scoped_lock lock (mutex_);
+          stop_ = true;
+          for (Jobs_t::const_iterator it = jobs_.begin ();
+              it != jobs_.end (); ++it)
+            running.push_back (it->second);
+          queued_.notify_all ();
+        }
+        for (std::size_t i = 0; i < running.size (); ++i)
+          running[i]->cancel (0);
+        threads_.join_all ();
+      }
+
+      SolveJobPtr_t SolveJobs::start (ProblemSolverPtr_t problemSolver)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        for (Jobs_t::const_iterator it = jobs_.begin ();
+            it != jobs_.end (); ++it)
+          if (it->second->problemSolver () == problemSolver
+              && !it->second->finished ())
+            throw std::runtime_error ("A planning job is already running on "
+                "this problem (job " + boost::lexical_cast <std::string>
+                (it->first) + ").");
+        prune ();
+        SolveJobPtr_t job (new SolveJob (nextId_, problemSolver));
+        jobs_[nextId_] = job;
+        ++nextId_;
+        queue_.push_back (job);
+        queued_.notify_one ();
+        return job;
+      }
+
+      SolveJobPtr_t SolveJobs::get (std::size_t id) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Jobs_t::const_iterator it = jobs_.find (id);
+        if (it == jobs_.end ())
+          throw std::out_of_range ("No planning job with id "
+              + boost::lexical_cast <std::string> (id) + ".");
+        return it->second;
+      }
+
+      bool SolveJobs::isBusy (ProblemSolverPtr_t problemSolver) const
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        for (Jobs_t::const_iterator it = jobs_.begin ();
+            it != jobs_.end (); ++it)
+          if (it->second->problemSolver () == problemSolver
+              && !it->second->finished ())
+            return true;
+        return false;
+      }
+
+      void SolveJobs::checkIdle (ProblemSolverPtr_t problemSolver,
+          const char* interfaceName, const char* operation) const
+      {
+        // Operations of the base classes of the servants, like _is_a, do not
+        // modify anything.
+        if (operation[0] == '_') return;
+        if (allowedDuringJob (interfaceName, operation)) return;
+        if (problemSolver != NULL && isBusy (problemSolver))
+          throw CORBA::BAD_INV_ORDER (0, CORBA::COMPLETED_NO);
+      }
+
+      void SolveJobs::prune ()
+      {
+        std::size_t finished = 0;
+        for (Jobs_t::const_iterator it = jobs_.begin ();
+            it != jobs_.end (); ++it)
+          if (it->second->finished ()) ++finished;
+        // Jobs are sorted by id, the oldest first.
+        for (Jobs_t::iterator it = jobs_.begin ();
+            finished > history_ && it != jobs_.end ();) {
+          if (it->second->finished ()) {
+            jobs_.erase (it++);
+            --finished;
+          } else
+            ++it;
+        }
+      }
+
+      void SolveJobs::work ()
+      {
+        while (true) {
+          SolveJobPtr_t job;
+          {
+            boost::mutex::scoped_lock lock (mutex_);
+            while (!stop_ && queue_.empty ()) queued_.wait (lock);
+            // Pending jobs are cancelled by the destructor, run them so that
+            // their state becomes terminal.
+            if (queue_.empty ()) return;
+            job = queue_.front ();
+            queue_.pop_front ();
+          }
+          job->run ();
+        }
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
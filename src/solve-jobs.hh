@@ -0,0 +1,180 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_SOLVE_JOBS_HH
+# define HPP_MANIPULATION_CORBA_SOLVE_JOBS_HH
+
+# include <deque>
+# include <map>
+# include <string>
+
+# include <boost/shared_ptr.hpp>
+# include <boost/thread/thread.hpp>
+# include <boost/thread/mutex.hpp>
+# include <boost/thread/condition_variable.hpp>
+# include <boost/date_time/posix_time/posix_time_types.hpp>
+
+# include <hpp/manipulation/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// A planning request executed outside of the ORB threads.
+      ///
+      /// The job runs the planner of a ProblemSolver step by step so that
+      /// progress can be observed and the run cancelled between two steps.
+      class SolveJob
+      {
+        public:
+          enum State {
+            PENDING,
+            RUNNING,
+            SUCCESS,
+            FAILURE,
+            CANCELLED
+          };
+
+          /// Snapshot of the job progress, updated after each planner step.
+          struct Status {
+            State state;
+            std::size_t iterations;
+            std::size_t nbNodes;
+            std::size_t nbEdges;
+            std::size_t nbConnectedComponents;
+            double elapsed;
+            long pathId;
+            std::string error;
+          };
+
+          SolveJob (std::size_t id, ProblemSolverPtr_t problemSolver);
+
+          std::size_t id () const
+          {
+            return id_;
+          }
+
+          ProblemSolverPtr_t problemSolver () const
+          {
+            return problemSolver_;
+          }
+
+          Status status () const;
+
+          bool finished () const;
+
+          /// Ask the job to stop and wait until it does.
+          /// \param timeout maximal waiting time in seconds. When negative,
+          ///        wait until the job stops.
+          /// \return whether the job is stopped.
+          bool cancel (double timeout);
+
+          /// Wait until the job stops.
+          /// \param timeout maximal waiting time in seconds. When negative,
+          ///        wait until the job stops.
+          /// \return whether the job is stopped.
+          bool wait (double timeout) const;
+
+          /// Mutex held by the worker while the planner executes a step.
+          ///
+          /// Lock it to read planner data (roadmap, edge statistics...)
+          /// while the job is running.
+          boost::mutex& stepMutex () const
+          {
+            return stepMutex_;
+          }
+
+          /// Executed by a worker thread of SolveJobs.
+          void run ();
+
+          static std::string toString (State state);
+
+        private:
+          void updateProgress (std::size_t iterations);
+          void terminate (State state, const std::string& error = "");
+
+          const std::size_t id_;
+          ProblemSolverPtr_t problemSolver_;
+
+          mutable boost::mutex mutex_;
+          mutable boost::condition_variable finished_;
+          mutable boost::mutex stepMutex_;
+          Status status_;
+          bool cancelRequested_;
+          boost::posix_time::ptime start_;
+      }; // class SolveJob
+      typedef boost::shared_ptr <SolveJob> SolveJobPtr_t;
+
+      /// Pool of threads dedicated to planning jobs.
+      ///
+      /// The finished jobs are kept, with their results, until more than a
+      /// given number of jobs finished after them.
+      class SolveJobs
+      {
+        public:
+          /// \param nbThreads number of worker threads. If 0, use the number
+          ///        of hardware threads. A single worker is enough unless
+          ///        jobs run on several problems at the same time.
+          /// \param history number of finished jobs kept.
+          SolveJobs (std::size_t nbThreads = 1, std::size_t history = 64);
+
+          ~SolveJobs ();
+
+          /// Queue a planning job on the given problem solver.
+          /// \throw std::runtime_error if a job is already pending or
+          ///        running on this problem solver.
+          SolveJobPtr_t start (ProblemSolverPtr_t problemSolver);
+
+          /// \throw std::out_of_range if no job has this id, or if the job
+          ///        is no longer in the history.
+          SolveJobPtr_t get (std::size_t id) const;
+
+          /// Whether a job is pending or running on the problem solver.
+          bool isBusy (ProblemSolverPtr_t problemSolver) const;
+
+          /// Refuse an operation of a servant while a job is pending or
+          /// running on the problem solver, as the job uses the problem
+          /// without locking it. Only the operations reading the jobs, the
+          /// metrics, the statistics and the versions are allowed.
+          ///
+          /// The servants of hpp-corbaserver are not guarded: their
+          /// operations on a problem with a job must be avoided by the
+          /// clients.
+          /// \throw CORBA::BAD_INV_ORDER if the operation is refused.
+          void checkIdle (ProblemSolverPtr_t problemSolver,
+              const char* interfaceName, const char* operation) const;
+
+        private:
+          void work ();
+
+          /// Drop the oldest finished jobs beyond the history.
+          void prune ();
+
+          typedef std::map <std::size_t, SolveJobPtr_t> Jobs_t;
+
+          mutable boost::mutex mutex_;
+          boost::condition_variable queued_;
+          std::deque <SolveJobPtr_t> queue_;
+          Jobs_t jobs_;
+          std::size_t nextId_;
+          const std::size_t history_;
+          bool stop_;
+          boost::thread_group threads_;
+      }; // class SolveJobs
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_SOLVE_JOBS_HH
@@ -0,0 +1,235 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "state-sampler.hh"
+
+#include <algorithm>
+#include <deque>
+#include <stdexcept>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <hpp/util/debug.hh>
+
+#include <hpp/pinocchio/device.hh>
+#include <hpp/core/collision-validation.hh>
+#include <hpp/core/config-validations.hh>
+#include <hpp/core/configuration-shooter.hh>
+#include <hpp/core/validation-report.hh>
+
+#include <hpp/manipulation/constraint-set.hh>
+#include <hpp/manipulation/device.hh>
+#include <hpp/manipulation/problem.hh>
+#include <hpp/manipulation/problem-solver.hh>
+#include <hpp/manipulation/graph/graph.hh>
+#include <hpp/manipulation/graph/state.hh>
+
+#include "metrics.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        /// Number of configurations waiting for their collision check, per
+        /// thread, beyond which the drawing waits.
+        const std::size_t chunk = 8;
+
+        /// A projected configuration, NULL if the projection failed.
+        struct Slot {
+          ConfigurationPtr_t config;
+          bool free;
+          bool checked;
+        };
+
+        /// Configurations drawn and not accepted or rejected yet, in the
+        /// order they were drawn.
+        struct Queue {
+          std::deque <Slot> slots;
+          /// Index in the draw order of the first slot.
+          std::size_t first;
+          /// Index of the next configuration to check.
+          std::size_t next;
+          bool stop;
+          std::string error;
+          boost::mutex mutex;
+          boost::condition_variable changed;
+        };
+
+        /// Check the collisions of the configurations of the queue on a
+        /// copy of the robot, until the queue is stopped.
+        struct Filter {
+          Queue& queue;
+          core::CollisionValidationPtr_t validation;
+
+          void operator() ()
+          {
+            boost::mutex::scoped_lock lock (queue.mutex);
+            while (true) {
+              while (!queue.stop
+                  && queue.next == queue.first + queue.slots.size ())
+                queue.changed.wait (lock);
+              if (queue.stop) return;
+              const std::size_t i = queue.next++;
+              // Failed projections are queued as checked.
+              if (queue.slots [i - queue.first].checked) continue;
+              ConfigurationPtr_t q = queue.slots [i - queue.first].config;
+              lock.unlock ();
+              bool free = false;
+              std::string error;
+              try {
+                core::ValidationReportPtr_t report;
+                free = validation->validate (*q, report);
+              } catch (const std::exception& e) {
+                error = e.what ();
+              }
+              lock.lock ();
+              if (!error.empty ()) {
+                queue.error = error;
+                queue.stop = true;
+              }
+              // The slot is still queued: the caller only removes checked
+              // slots.
+              Slot& slot = queue.slots [i - queue.first];
+              slot.free = free;
+              slot.checked = true;
+              queue.changed.notify_all ();
+            }
+          }
+        };
+
+        /// Stop and join the workers, also when sampling throws.
+        struct Workers {
+          Queue& queue;
+          boost::thread_group threads;
+
+          Workers (Queue& q) : queue (q) {}
+
+          ~Workers ()
+          {
+            {
+              boost::mutex::scoped_lock lock (queue.mutex);
+              queue.stop = true;
+              queue.changed.notify_all ();
+            }
+            threads.join_all ();
+          }
+        };
+      }
+
+      StateSampler::Samples StateSampler::sample
+      (const ProblemSolverPtr_t& problemSolver,
+       const graph::StatePtr_t& state, std::size_t n, value_type timeBudget)
+      {
+        if (!(timeBudget > 0))
+          throw std::invalid_argument ("The time budget must be positive");
+        const graph::GraphPtr_t& graph = problemSolver->constraintGraph ();
+        if (!graph) throw std::runtime_error ("You should create the graph");
+        DevicePtr_t robot = problemSolver->robot ();
+        ConstraintSetPtr_t constraint = graph->configConstraint (state);
+        const core::ProblemPtr_t& problem = problemSolver->problem ();
+        core::ConfigurationShooterPtr_t shooter =
+          problem->configurationShooter ();
+        const core::ObjectStdVector_t& obstacles =
+          problem->collisionObstacles ();
+
+        const ServerMetrics::value_type deadline = ServerMetrics::now ()
+          + (ServerMetrics::value_type) (timeBudget * 1e9);
+        Samples samples;
+        samples.trials = 0;
+        if (n == 0) return samples;
+
+        // The validations of the problem, but the collision validation,
+        // which the workers run.
+        core::ConfigValidationsPtr_t validations =
+          core::ConfigValidations::create ();
+        const std::vector <std::string> types =
+          problemSolver->configValidationTypes ();
+        for (std::size_t i = 0; i < types.size (); ++i)
+          if (types[i] != "CollisionValidation")
+            validations->add (problemSolver->configValidations.get
+                (types[i]) (robot));
+
+        // One collision validation per worker, on its own copy of the robot.
+        const std::size_t nThreads =
+          std::max (boost::thread::hardware_concurrency (), 1u);
+        Queue queue;
+        queue.first = queue.next = 0;
+        queue.stop = false;
+        Workers workers (queue);
+        for (std::size_t i = 0; i < nThreads; ++i) {
+          core::DevicePtr_t copy (pinocchio::Device::createCopy (robot));
+          Filter filter = { queue, core::CollisionValidation::create (copy) };
+          for (std::size_t j = 0; j < obstacles.size (); ++j)
+            filter.validation->addObstacle (obstacles[j]);
+          workers.threads.create_thread (filter);
+        }
+
+        // The constraints of the state evaluate through the robot, so
+        // configurations are drawn and projected by the calling thread,
+        // while the workers check the collisions of the previous ones. The
+        // checked configurations are validated in the order they were
+        // drawn, so that the same configurations are accepted as by a
+        // sequential loop.
+        std::size_t attempts = 0;
+        bool drawing = true;
+        boost::mutex::scoped_lock lock (queue.mutex);
+        while (samples.configurations.size () < n) {
+          if (!queue.error.empty ()) throw std::runtime_error (queue.error);
+          if (!queue.slots.empty () && queue.slots.front ().checked) {
+            Slot slot = queue.slots.front ();
+            queue.slots.pop_front ();
+            ++queue.first;
+            queue.next = std::max (queue.next, queue.first);
+            lock.unlock ();
+            ++samples.trials;
+            ++attempts;
+            core::ValidationReportPtr_t report;
+            if (slot.free && validations->validate (*slot.config, report)) {
+              samples.configurations.push_back (*slot.config);
+              samples.attempts.push_back (attempts);
+              attempts = 0;
+            }
+            lock.lock ();
+            continue;
+          }
+          drawing = drawing && ServerMetrics::now () < deadline;
+          if (!drawing && queue.slots.empty ()) break;
+          if (!drawing || queue.slots.size () >= chunk * nThreads) {
+            queue.changed.wait (lock);
+            continue;
+          }
+          lock.unlock ();
+          Slot slot;
+          slot.config = shooter->shoot ();
+          if (constraint && !constraint->apply (*slot.config))
+            slot.config.reset ();
+          slot.free = false;
+          slot.checked = !slot.config;
+          lock.lock ();
+          queue.slots.push_back (slot);
+          queue.changed.notify_all ();
+        }
+        lock.unlock ();
+        hppDout (info, state->name () << ": "
+            << samples.configurations.size () << " configurations in "
+            << samples.trials << " trials on " << nThreads << " threads");
+        return samples;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_STATE_SAMPLER_HH
+# define HPP_MANIPULATION_CORBA_STATE_SAMPLER_HH
+
+# include <vector>
+
+# include <hpp/manipulation/fwd.hh>
+# include <hpp/manipulation/graph/fwd.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Valid configurations in a state of the constraint graph.
+      ///
+      /// Random configurations are projected on the constraints of the
+      /// state and checked by the configuration validations of the problem,
+      /// until enough of them are accepted or the time budget is spent.
+      ///
+      /// Configurations are drawn and projected on the calling thread, as
+      /// the constraints evaluate through the robot. Meanwhile, a pool of
+      /// workers checks their collisions, each with its own copy of the
+      /// robot, against the obstacles of the problem. The collision free
+      /// configurations are then checked, in the order they were drawn, by
+      /// the other configuration validations of the problem.
+      struct StateSampler
+      {
+        struct Samples {
+          std::vector <Configuration_t> configurations;
+          /// Number of random configurations drawn for each accepted one,
+          /// including it.
+          std::vector <std::size_t> attempts;
+          /// Number of random configurations drawn.
+          std::size_t trials;
+        };
+
+        /// \param n number of configurations requested,
+        /// \param timeBudget time after which sampling stops, in seconds.
+        /// \return at most n configurations.
+        static Samples sample (const ProblemSolverPtr_t& problemSolver,
+            const graph::StatePtr_t& state, std::size_t n,
+            value_type timeBudget);
+      }; // struct StateSampler
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_STATE_SAMPLER_HH
@@ -0,0 +1,175 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#include "versions.hh"
+
+#include <set>
+
+#include <boost/thread/tss.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <hpp/corbaserver/manipulation/server.hh>
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      namespace {
+        typedef std::set <std::string> Operations_t;
+
+        void noCleanup (Versions::Update*) {}
+
+        /// Update of the call being dispatched by the current thread.
+        boost::thread_specific_ptr <Versions::Update> current (noCleanup);
+
+        // Operations that do not modify the data returned by the cached
+        // queries. Any other operation is assumed to modify something.
+        const char* graphReadOnly [] = {
+          "getGraph", "getEdgeStat", "getFrequencyOfNodeInRoadmap",
+          "getNearestNodesInState", "getNodesInStateWithinRadius",
+          "getConfigProjectorStats", "getWaypoint", "getContainingNode",
+          "getNumericalConstraints", "getLockedJoints", "getNode",
+          "getConfigErrorForNode", "getConfigErrorForEdge",
+          "getConfigErrorForEdgeLeaf", "getConfigErrorForEdgeTarget",
+          "displayNodeConstraints", "displayEdgeConstraints",
+          "displayEdgeTargetConstraints", "getNodesConnectedByEdge",
+          "display", "getHistogramValue", "isShort", "getWeight",
+          "getRelativeMotionMatrix", "computeGraspFeasibility",
+          "setGraspFeasibility", "getGraspFeasibility",
+          "setInitializeThreads", "getInitializeTimes",
+          "setLazyInitialization", "completeInitialization",
+          "getLazyInitializationStats"
+        };
+
+        const char* problemReadOnly [] = {
+          "selectProblem", "getAvailable", "getEnvironmentContactNames",
+          "getRobotContactNames", "getEnvironmentContact", "getRobotContact",
+          "applyConstraints", "applyConstraintsWithOffset",
+          "openProjectionSession", "projectInSession",
+          "closeProjectionSession", "generateValidConfigsInState",
+          "validateConfigurations",
+          "buildAndProjectPath", "edgeAtParam", "samplePath", "startSolve",
+          "getSolveStatus", "getSolveEdgeStats", "cancelSolve", "waitSolve",
+          "getServerMetrics", "resetServerMetrics", "getQueueMetrics",
+          "getVersions", "setProjectionCache", "getProjectionCacheStats",
+          "openSharedChannel", "closeSharedChannel",
+          "sendRoadmapNodes", "sendPathSamples", "exportRoadmap"
+        };
+
+        const char* robotReadOnly [] = {
+          "getRootJointPosition", "getGripperPositionInJoint",
+          "getHandlePositionInJoint", "beginSceneAssembly",
+          "mergeEnvironmentObstacles", "getLoadTimes", "getGripperPositions",
+          "getHandlePositions"
+        };
+
+        template <std::size_t N>
+        Operations_t toSet (const char* (&ops) [N])
+        {
+          return Operations_t (ops, ops + N);
+        }
+
+        const Operations_t& readOnly (const std::string& interfaceName)
+        {
+          static const Operations_t graph (toSet (graphReadOnly));
+          static const Operations_t problem (toSet (problemReadOnly));
+          static const Operations_t robot (toSet (robotReadOnly));
+          static const Operations_t none;
+          if (interfaceName == "Graph") return graph;
+          if (interfaceName == "Problem") return problem;
+          if (interfaceName == "Robot") return robot;
+          return none;
+        }
+      }
+
+      Versions::Update::Update (Server& server, const char* interfaceName,
+          const char* operation) :
+        server_ (server), interface_ (interfaceName), operation_ (operation),
+        previous_ (current.get ()), discarded_ (false), applied_ (false)
+      {
+        current.reset (this);
+      }
+
+      Versions::Update::~Update ()
+      {
+        current.reset (previous_);
+        apply ();
+      }
+
+      void Versions::Update::replyStarted ()
+      {
+        if (current.get () != NULL) current->apply ();
+      }
+
+      void Versions::Update::apply ()
+      {
+        if (discarded_ || applied_) return;
+        applied_ = true;
+        int parts = modifiedBy (interface_, operation_);
+        if (parts == 0) return;
+        server_.versions ().modified
+          (server_.problemSolverMap ()->selected_, parts);
+      }
+
+      Versions::Versions ()
+      {
+        using namespace boost::posix_time;
+        const ptime epoch (boost::gregorian::date (1970, 1, 1));
+        last_ = (value_type) (microsec_clock::universal_time () - epoch)
+          .total_microseconds ();
+      }
+
+      Versions::Stamps Versions::get (const std::string& problemName)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        return stamps (problemName);
+      }
+
+      void Versions::modified (const std::string& problemName, int parts)
+      {
+        boost::mutex::scoped_lock lock (mutex_);
+        Stamps& s = stamps (problemName);
+        ++last_;
+        if (parts & PROBLEM) s.problem = last_;
+        if (parts & GRAPH) s.graph = last_;
+        if (parts & ROBOT) s.robot = last_;
+      }
+
+      int Versions::modifiedBy (const std::string& interfaceName,
+          const std::string& operation)
+      {
+        if (readOnly (interfaceName).count (operation)) return 0;
+        if (interfaceName == "Graph") return GRAPH;
+        // Loading models resets the problem and its graph.
+        if (interfaceName == "Robot") return ALL;
+        if (operation == "resetProblem") return ALL;
+        return PROBLEM;
+      }
+
+      Versions::Stamps& Versions::stamps (const std::string& problemName)
+      {
+        std::map <std::string, Stamps>::iterator it =
+          stamps_.find (problemName);
+        if (it != stamps_.end ()) return it->second;
+        // A problem never seen gets new stamps, different from the stamps
+        // of any other problem.
+        ++last_;
+        Stamps s;
+        s.problem = s.graph = s.robot = last_;
+        return stamps_.insert (std::make_pair (problemName, s)).first->second;
+      }
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
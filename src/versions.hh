@@ -0,0 +1,116 @@
+// Copyright (c) 2026 CNRS
+//
+// This file is part of hpp-manipulation-corba.
+// hpp-manipulation-corba is free software: you can redistribute it
+// and/or modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation, either version
+// 3 of the License, or (at your option) any later version.
+//
+// hpp-manipulation-corba is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty
+// of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// General Lesser Public License for more details.  You should have
+// received a copy of the GNU Lesser General Public License along with
+// hpp-manipulation-corba.  If not, see
+// <http://www.gnu.org/licenses/>.
+
+#ifndef HPP_MANIPULATION_CORBA_VERSIONS_HH
+# define HPP_MANIPULATION_CORBA_VERSIONS_HH
+
+# include <map>
+# include <string>
+
+# include <boost/cstdint.hpp>
+# include <boost/thread/mutex.hpp>
+
+# include "hpp/corbaserver/manipulation/fwd.hh"
+
+namespace hpp {
+  namespace manipulation {
+    namespace impl {
+      /// Version stamps of the problem, constraint graph and robot of each
+      /// problem of the server.
+      ///
+      /// Stamps are drawn from a single counter, so that a stamp is never
+      /// reused, even across problems. The counter starts from the number of
+      /// microseconds since the epoch, so that a restarted server does not
+      /// reuse the stamps of the previous one. Stamps are updated by each
+      /// call to an operation of the servants that is not known to be
+      /// read-only, before the reply is sent.
+      /// Modifications made through other servants (hpp-corbaserver) are
+      /// not tracked.
+      class Versions
+      {
+        public:
+          typedef boost::uint64_t value_type;
+
+          enum Part {
+            PROBLEM = 1,
+            GRAPH = 2,
+            ROBOT = 4,
+            ALL = PROBLEM | GRAPH | ROBOT
+          };
+
+          struct Stamps {
+            value_type problem;
+            value_type graph;
+            value_type robot;
+          };
+
+          /// Record the call to a servant operation, once it returned.
+          ///
+          /// Create an instance on the stack of the servant dispatch method.
+          /// The stamps are updated when the reply starts, so that a client
+          /// receiving the reply sees the new stamps, or at destruction for
+          /// collocated calls.
+          class Update
+          {
+            public:
+              Update (Server& server, const char* interfaceName,
+                  const char* operation);
+
+              ~Update ();
+
+              /// Called by the interceptors when the reply of the call
+              /// dispatched by the current thread starts.
+              static void replyStarted ();
+
+              /// The request was not for this servant.
+              void discard ()
+              {
+                discarded_ = true;
+              }
+
+            private:
+              void apply ();
+
+              Server& server_;
+              const char* interface_;
+              const char* operation_;
+              Update* previous_;
+              bool discarded_;
+              bool applied_;
+          }; // class Update
+
+          Versions ();
+
+          Stamps get (const std::string& problemName);
+
+          void modified (const std::string& problemName, int parts);
+
+          /// Parts modified by an operation of a servant.
+          static int modifiedBy (const std::string& interfaceName,
+              const std::string& operation);
+
+        private:
+          Stamps& stamps (const std::string& problemName);
+
+          boost::mutex mutex_;
+          value_type last_;
+          std::map <std::string, Stamps> stamps_;
+      }; // class Versions
+    } // namespace impl
+  } // namespace manipulation
+} // namespace hpp
+
+#endif // HPP_MANIPULATION_CORBA_VERSIONS_HH